@@ -1,4 +1,5 @@
 #include "CashFlow.hpp"
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
 
@@ -61,4 +62,29 @@ std::vector<CashFlow> bulletSchedule(double face, double cpnRate,
   return cashFlows;
 }
 
-} // namespace quant
\ No newline at end of file
+std::optional<BulletTerms> bulletTerms(double face, double cpnRate,
+                                       int couponPerYear,
+                                       double maturityYears) {
+  if (couponPerYear <= 0 || !(maturityYears > 0.0) ||
+      std::isinf(maturityYears)) {
+    return std::nullopt;
+  }
+
+  // Same payment count as bulletSchedule
+  int totalPayments = std::lround(maturityYears * couponPerYear);
+  if (totalPayments < 1) {
+    return std::nullopt;
+  }
+
+  double period = 1.0 / couponPerYear;
+  double lastRegular = totalPayments * period;
+  if (std::abs(lastRegular - maturityYears) >
+      1e-12 * std::max(1.0, maturityYears)) {
+    return std::nullopt; // Final payment pulled to an off-grid maturity
+  }
+
+  return BulletTerms{face, (cpnRate * face) / couponPerYear, period,
+                     totalPayments};
+}
+
+} // namespace quant
@@ -1,4 +1,5 @@
 #pragma once
+#include <optional>
 #include <vector>
 
 namespace quant {
@@ -13,4 +14,20 @@ struct CashFlow {
                                                    int couponPerYear = 2,
                                                    double maturityYears = 1.0);
 
+// Level-coupon bullet schedule with payments every `period` years:
+// `periods` coupons of `coupon`, plus `face` on the last payment date
+struct BulletTerms {
+  double face;
+  double coupon; // coupon amount per period
+  double period; // years between payments
+  int periods;   // number of coupon payments
+};
+
+// Terms of bulletSchedule(face, cpnRate, couponPerYear, maturityYears) when
+// its payments are evenly spaced out to maturity (maturity is a whole number
+// of coupon periods); std::nullopt for irregular or zero-coupon schedules
+[[nodiscard]] std::optional<BulletTerms>
+bulletTerms(double face, double cpnRate, int couponPerYear,
+            double maturityYears);
+
 } // namespace quant
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include "CashFlowBlock.hpp"
+#include <stdexcept>
+
+namespace quant {
+
+void CashFlowBlock::reserve(std::size_t positions, std::size_t flows) {
+  times_.reserve(flows);
+  amounts_.reserve(flows);
+  offsets_.reserve(positions + 1);
+}
+
+void CashFlowBlock::add(const std::vector<CashFlow> &cashFlows,
+                        double quantity) {
+  for (const auto &cf : cashFlows) {
+    times_.push_back(cf.time);
+    amounts_.push_back(quantity * cf.amount);
+  }
+  offsets_.push_back(times_.size());
+}
+
+void CashFlowBlock::add(QUANT_SPAN<const double> times,
+                        QUANT_SPAN<const double> amounts, double quantity) {
+  if (times.size() != amounts.size()) {
+    throw std::invalid_argument("Times and amounts must have the same size");
+  }
+  for (std::size_t i = 0; i < times.size(); ++i) {
+    times_.push_back(times[i]);
+    amounts_.push_back(quantity * amounts[i]);
+  }
+  offsets_.push_back(times_.size());
+}
+
+QUANT_SPAN<const double> CashFlowBlock::times(std::size_t position) const {
+  return {times_.data() + offsets_[position],
+          offsets_[position + 1] - offsets_[position]};
+}
+
+QUANT_SPAN<const double> CashFlowBlock::amounts(std::size_t position) const {
+  return {amounts_.data() + offsets_[position],
+          offsets_[position + 1] - offsets_[position]};
+}
+
+void CashFlowBlock::price(const DiscountCurve &curve, std::size_t begin,
+                          std::size_t end, QUANT_SPAN<double> out,
+                          std::vector<double> &scratch) const {
+  if (begin > end || end > positions()) {
+    throw std::out_of_range("CashFlowBlock position range out of bounds");
+  }
+  if (out.size() < end - begin) {
+    throw std::invalid_argument("Output too small for position range");
+  }
+
+  const std::size_t first = offsets_[begin];
+  const std::size_t count = offsets_[end] - first;
+  scratch.resize(count);
+  curve.df(QUANT_SPAN<const double>(times_.data() + first, count),
+           QUANT_SPAN<double>(scratch.data(), count));
+
+  for (std::size_t p = begin; p < end; ++p) {
+    double pv = 0.0;
+    for (std::size_t i = offsets_[p]; i < offsets_[p + 1]; ++i) {
+      pv += amounts_[i] * scratch[i - first];
+    }
+    out[p - begin] = pv;
+  }
+}
+
+} // namespace quant
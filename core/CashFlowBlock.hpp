@@ -0,0 +1,45 @@
+#pragma once
+#include "CashFlow.hpp"
+#include "DiscountCurve.hpp"
+#include "HugePages.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace quant {
+
+// Cash flows of many positions in structure-of-arrays form: one contiguous
+// array of times and one of amounts, with offsets_[p]..offsets_[p+1]
+// delimiting position p. Amounts are stored already scaled by the position
+// quantity, so pricing a position is a dot product with discount factors.
+// The flow arrays use HugePageAllocator, so large books are backed by huge
+// pages under the process-wide policy.
+class CashFlowBlock {
+public:
+  CashFlowBlock() : offsets_{0} {}
+
+  void reserve(std::size_t positions, std::size_t flows);
+  void add(const std::vector<CashFlow> &cashFlows, double quantity = 1.0);
+  void add(QUANT_SPAN<const double> times, QUANT_SPAN<const double> amounts,
+           double quantity = 1.0);
+
+  std::size_t positions() const { return offsets_.size() - 1; }
+  std::size_t flows() const { return times_.size(); }
+
+  QUANT_SPAN<const double> times(std::size_t position) const;
+  QUANT_SPAN<const double> amounts(std::size_t position) const;
+
+  // Present values of positions [begin, end) into out[0, end - begin).
+  // Discount factors for the whole range are evaluated in one batched call;
+  // scratch is resized as needed and can be reused across calls.
+  void price(const DiscountCurve &curve, std::size_t begin, std::size_t end,
+             QUANT_SPAN<double> out, std::vector<double> &scratch) const;
+
+private:
+  HugePageVector<double> times_{
+      HugePageAllocator<double>("CashFlowBlock.times")};
+  HugePageVector<double> amounts_{
+      HugePageAllocator<double>("CashFlowBlock.amounts")};
+  std::vector<std::size_t> offsets_;
+};
+
+} // namespace quant
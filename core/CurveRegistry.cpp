@@ -0,0 +1,233 @@
+#include "CurveRegistry.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+
+namespace quant {
+
+std::uint64_t CurveRegistry::Instance::next() {
+  static std::atomic<std::uint64_t> counter{0};
+  return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+CurveRegistry::CurveId CurveRegistry::registerNode(const std::string &name) {
+  if (name.empty()) {
+    throw std::invalid_argument("Curve name must not be empty");
+  }
+  if (index_.count(name) != 0) {
+    throw std::invalid_argument("Curve already registered: " + name);
+  }
+
+  CurveId id = nodes_.size();
+  nodes_.emplace_back();
+  nodes_.back().name = name;
+  index_.emplace(name, id);
+  return id;
+}
+
+CurveRegistry::CurveId CurveRegistry::addCurve(const std::string &name,
+                                               DiscountCurve curve) {
+  CurveId id = registerNode(name);
+  Node &node = nodes_[id];
+  node.curve.emplace(std::move(curve));
+  node.stale = false;
+  node.version = 1;
+  return id;
+}
+
+CurveRegistry::CurveId
+CurveRegistry::addDerived(const std::string &name,
+                          const std::vector<std::string> &dependencies,
+                          Builder builder) {
+  if (!builder) {
+    throw std::invalid_argument("Derived curve requires a builder: " + name);
+  }
+  if (dependencies.empty()) {
+    throw std::invalid_argument("Derived curve requires dependencies: " +
+                                name);
+  }
+
+  // Resolve dependencies before registering so a failure leaves no trace
+  std::vector<CurveId> deps;
+  deps.reserve(dependencies.size());
+  for (const auto &dep : dependencies) {
+    deps.push_back(id(dep));
+  }
+
+  CurveId nodeId = registerNode(name);
+  Node &node = nodes_[nodeId];
+  node.deps = std::move(deps);
+  node.builder = std::move(builder);
+
+  for (CurveId dep : node.deps) {
+    node.level = std::max(node.level, nodes_[dep].level + 1);
+    nodes_[dep].children.push_back(nodeId);
+  }
+  return nodeId;
+}
+
+void CurveRegistry::update(const std::string &name, DiscountCurve curve) {
+  CurveId nodeId = id(name);
+  Node &node = nodes_[nodeId];
+  if (node.builder) {
+    throw std::invalid_argument("Cannot update derived curve directly: " +
+                                name);
+  }
+  node.curve = std::move(curve);
+  ++node.version;
+  markDownstreamStale(nodeId);
+}
+
+void CurveRegistry::invalidate(const std::string &name) {
+  CurveId nodeId = id(name);
+  if (nodes_[nodeId].builder) {
+    nodes_[nodeId].stale = true;
+  }
+  markDownstreamStale(nodeId);
+}
+
+const DiscountCurve &CurveRegistry::curve(const std::string &name) {
+  CurveId nodeId = id(name);
+  if (nodes_[nodeId].stale) {
+    rebuildNodes(staleAncestors(nodeId));
+  }
+  return *nodes_[nodeId].curve;
+}
+
+void CurveRegistry::rebuild() {
+  std::vector<CurveId> stale;
+  for (CurveId i = 0; i < nodes_.size(); ++i) {
+    if (nodes_[i].stale)
+      stale.push_back(i);
+  }
+  rebuildNodes(std::move(stale));
+}
+
+bool CurveRegistry::contains(const std::string &name) const {
+  return index_.count(name) != 0;
+}
+
+bool CurveRegistry::isStale(const std::string &name) const {
+  return nodes_[id(name)].stale;
+}
+
+CurveRegistry::CurveId CurveRegistry::id(const std::string &name) const {
+  auto it = index_.find(name);
+  if (it == index_.end()) {
+    throw std::invalid_argument("Unknown curve: " + name);
+  }
+  return it->second;
+}
+
+std::uint64_t CurveRegistry::version(const std::string &name) const {
+  return nodes_[id(name)].version;
+}
+
+std::vector<std::string>
+CurveRegistry::downstream(const std::string &name) const {
+  std::vector<bool> seen(nodes_.size(), false);
+  std::vector<CurveId> stack{id(name)};
+  while (!stack.empty()) {
+    CurveId cur = stack.back();
+    stack.pop_back();
+    for (CurveId child : nodes_[cur].children) {
+      if (!seen[child]) {
+        seen[child] = true;
+        stack.push_back(child);
+      }
+    }
+  }
+
+  // Ids are assigned in registration order, which is a topological order
+  std::vector<std::string> names;
+  for (CurveId i = 0; i < nodes_.size(); ++i) {
+    if (seen[i])
+      names.push_back(nodes_[i].name);
+  }
+  return names;
+}
+
+void CurveRegistry::markDownstreamStale(CurveId nodeId) {
+  std::vector<CurveId> stack(nodes_[nodeId].children);
+  while (!stack.empty()) {
+    CurveId cur = stack.back();
+    stack.pop_back();
+    if (nodes_[cur].stale) {
+      // A stale curve never has fresh dependents, so its subtree is done
+      continue;
+    }
+    nodes_[cur].stale = true;
+    stack.insert(stack.end(), nodes_[cur].children.begin(),
+                 nodes_[cur].children.end());
+  }
+}
+
+std::vector<CurveRegistry::CurveId>
+CurveRegistry::staleAncestors(CurveId nodeId) const {
+  std::vector<bool> seen(nodes_.size(), false);
+  std::vector<CurveId> stack{nodeId};
+  std::vector<CurveId> result;
+  seen[nodeId] = true;
+
+  while (!stack.empty()) {
+    CurveId cur = stack.back();
+    stack.pop_back();
+    result.push_back(cur);
+    for (CurveId dep : nodes_[cur].deps) {
+      if (!seen[dep] && nodes_[dep].stale) {
+        seen[dep] = true;
+        stack.push_back(dep);
+      }
+    }
+  }
+  return result;
+}
+
+void CurveRegistry::rebuildNodes(std::vector<CurveId> stale) {
+  if (stale.empty())
+    return;
+
+  // Group by depth: every dependency of a level-k node sits at a lower
+  // level, so all nodes within one level can be built concurrently.
+  std::sort(stale.begin(), stale.end(), [this](CurveId a, CurveId b) {
+    return nodes_[a].level != nodes_[b].level
+               ? nodes_[a].level < nodes_[b].level
+               : a < b;
+  });
+
+  auto levelBegin = stale.begin();
+  while (levelBegin != stale.end()) {
+    std::size_t level = nodes_[*levelBegin].level;
+    auto levelEnd = std::find_if(levelBegin, stale.end(), [&](CurveId i) {
+      return nodes_[i].level != level;
+    });
+
+    std::vector<CurveId> batch(levelBegin, levelEnd);
+    std::vector<std::optional<DiscountCurve>> built(batch.size());
+
+    parallelFor(
+        batch.size(),
+        [&](std::size_t k) {
+          const Node &node = nodes_[batch[k]];
+          std::vector<const DiscountCurve *> deps;
+          deps.reserve(node.deps.size());
+          for (CurveId dep : node.deps) {
+            deps.push_back(&*nodes_[dep].curve);
+          }
+          built[k].emplace(node.builder(deps));
+        },
+        threads_);
+
+    // Publish only after the whole level succeeded
+    for (std::size_t k = 0; k < batch.size(); ++k) {
+      Node &node = nodes_[batch[k]];
+      node.curve = std::move(built[k]);
+      node.stale = false;
+      ++node.version;
+    }
+    levelBegin = levelEnd;
+  }
+}
+
+} // namespace quant
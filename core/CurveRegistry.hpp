@@ -0,0 +1,111 @@
+#pragma once
+#include "DiscountCurve.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace quant {
+
+// Registry of named curves with declared dependencies (e.g. a spread curve on
+// top of an OIS base, or a projection curve built off the discount curve).
+//
+// Input curves are supplied directly; derived curves are produced by a
+// builder from their dependencies. Updating a curve marks everything
+// downstream of it stale, and stale curves are rebuilt lazily on access, in
+// topological order, with independent curves of the same depth rebuilt in
+// parallel. Dependencies must be registered before their dependents, so the
+// graph is acyclic by construction.
+//
+// The registry itself is not thread-safe: updates and lookups must come from
+// one thread (builders are the only code run concurrently).
+class CurveRegistry {
+public:
+  using CurveId = std::size_t;
+
+  // Builder receives the dependency curves in declaration order
+  using Builder = std::function<DiscountCurve(
+      const std::vector<const DiscountCurve *> &dependencies)>;
+
+  explicit CurveRegistry(std::size_t threads = 0) : threads_(threads) {}
+
+  // Register an input curve with no dependencies
+  CurveId addCurve(const std::string &name, DiscountCurve curve);
+
+  // Register a curve built from already-registered dependencies. It is not
+  // built until first requested.
+  CurveId addDerived(const std::string &name,
+                     const std::vector<std::string> &dependencies,
+                     Builder builder);
+
+  // Replace an input curve and invalidate all curves downstream of it
+  void update(const std::string &name, DiscountCurve curve);
+
+  // Force a derived curve (and its dependents) to be rebuilt on next access
+  void invalidate(const std::string &name);
+
+  // Curve by name, rebuilding stale ancestors first. The reference stays
+  // valid for the lifetime of the registry; its value changes on rebuild.
+  const DiscountCurve &curve(const std::string &name);
+
+  // Rebuild every stale curve
+  void rebuild();
+
+  bool contains(const std::string &name) const;
+  bool isStale(const std::string &name) const;
+  CurveId id(const std::string &name) const;
+  std::size_t size() const { return nodes_.size(); }
+
+  // Incremented every time the curve is replaced or rebuilt; lets consumers
+  // key caches on (instance, name, version)
+  std::uint64_t version(const std::string &name) const;
+
+  // Process-wide unique identity of this registry. A copy gets a new one,
+  // since the copies' curves diverge while their versions may coincide.
+  std::uint64_t instance() const { return instance_.value; }
+
+  // Names of all curves that (transitively) depend on the given curve, in
+  // topological order
+  std::vector<std::string> downstream(const std::string &name) const;
+
+private:
+  struct Node {
+    std::string name;
+    std::vector<CurveId> deps;
+    std::vector<CurveId> children;
+    Builder builder; // empty for input curves
+    std::optional<DiscountCurve> curve;
+    bool stale = true;
+    std::uint64_t version = 0;
+    std::size_t level = 0; // 0 for inputs, 1 + max(dep levels) otherwise
+  };
+
+  // Fresh value on construction and on copy; never reused in the process
+  struct Instance {
+    std::uint64_t value = next();
+    Instance() = default;
+    Instance(const Instance &) : value(next()) {}
+    Instance &operator=(const Instance &) {
+      value = next();
+      return *this;
+    }
+    static std::uint64_t next();
+  };
+
+  Instance instance_;
+  // std::deque keeps node addresses (and returned curve references) stable
+  std::deque<Node> nodes_;
+  std::unordered_map<std::string, CurveId> index_;
+  std::size_t threads_;
+
+  CurveId registerNode(const std::string &name);
+  void markDownstreamStale(CurveId id);
+  void rebuildNodes(std::vector<CurveId> stale);
+  std::vector<CurveId> staleAncestors(CurveId id) const;
+};
+
+} // namespace quant
@@ -0,0 +1,101 @@
+#include "DfTable.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace quant {
+
+namespace {
+// Recompute a grid point exactly every so often to bound the error that
+// accumulates in the geometric recurrence
+constexpr std::size_t kResyncInterval = 256;
+} // namespace
+
+DfTable::DfTable(const DiscountCurve &curve, double step, double horizon)
+    : curve_(&curve), step_(step), invStep_(0.0), horizon_(horizon),
+      lastIndex_(0.0) {
+  if (!(step > 0.0) || std::isinf(step)) {
+    throw std::invalid_argument("Grid step must be positive and finite");
+  }
+  if (std::isnan(horizon) || std::isinf(horizon) || horizon < 0.0) {
+    throw std::invalid_argument("Grid horizon must be non-negative and finite");
+  }
+  if (horizon == 0.0) {
+    if (curve.isFlat()) {
+      throw std::invalid_argument("Flat curve requires an explicit horizon");
+    }
+    horizon_ = curve.pillars().back().time;
+  }
+
+  invStep_ = 1.0 / step_;
+  auto points = static_cast<std::size_t>(std::ceil(horizon_ * invStep_)) + 1;
+  grid_.resize(points);
+  lastIndex_ = static_cast<double>(points - 1);
+
+  rebuild(curve);
+}
+
+void DfTable::rebuild(const DiscountCurve &curve) {
+  curve_ = &curve;
+  const std::size_t n = grid_.size();
+  grid_[0] = 1.0;
+
+  if (curve.isFlat()) {
+    // Constant ratio between consecutive grid points
+    double ratio = curve.df(step_);
+    for (std::size_t k = 1; k < n; ++k) {
+      grid_[k] = (k % kResyncInterval == 0)
+                     ? curve.df(static_cast<double>(k) * step_)
+                     : grid_[k - 1] * ratio;
+    }
+    return;
+  }
+
+  const auto &pillars = curve.pillars();
+  std::size_t k = 1;
+
+  // Flat extrapolation before the first pillar
+  for (; k < n && static_cast<double>(k) * step_ <= pillars.front().time;
+       ++k) {
+    grid_[k] = pillars.front().df;
+  }
+
+  // Within each log-linear segment consecutive grid points differ by the
+  // constant factor exp(slope * step)
+  for (std::size_t j = 1; j < pillars.size() && k < n; ++j) {
+    double t0 = pillars[j - 1].time;
+    double t1 = pillars[j].time;
+    if (t1 <= t0)
+      continue;
+
+    double logDf0 = std::log(pillars[j - 1].df);
+    double slope = (std::log(pillars[j].df) - logDf0) / (t1 - t0);
+    double ratio = std::exp(slope * step_);
+
+    bool first = true;
+    for (; k < n && static_cast<double>(k) * step_ <= t1; ++k) {
+      double t = static_cast<double>(k) * step_;
+      if (first || k % kResyncInterval == 0) {
+        grid_[k] = std::exp(logDf0 + slope * (t - t0));
+        first = false;
+      } else {
+        grid_[k] = grid_[k - 1] * ratio;
+      }
+    }
+  }
+
+  // Flat extrapolation after the last pillar
+  for (; k < n; ++k) {
+    grid_[k] = pillars.back().df;
+  }
+}
+
+void DfTable::df(QUANT_SPAN<const double> times, QUANT_SPAN<double> out) const {
+  if (times.size() != out.size()) {
+    throw std::invalid_argument("Output size must match number of times");
+  }
+  for (std::size_t i = 0; i < times.size(); ++i) {
+    out[i] = df(times[i]);
+  }
+}
+
+} // namespace quant
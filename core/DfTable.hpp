@@ -0,0 +1,56 @@
+#pragma once
+#include "DiscountCurve.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace quant {
+
+// Precomputed discount factors on a uniform time grid (daily by default).
+//
+// df(t) becomes an index computation plus one linear correction between the
+// two neighbouring grid points. Grid points reproduce the curve exactly; in
+// between, the linear-in-df error relative to the curve's log-linear
+// interpolation is about r^2 * step^2 / 8 (~2e-9 for 5% rates on a daily
+// grid). Beyond the horizon the source curve is used directly, so it must
+// outlive the table.
+class DfTable {
+public:
+  static constexpr double kDailyStep = 1.0 / 365.0;
+
+  // horizon = 0 means "last pillar" and is only valid for bootstrapped curves
+  explicit DfTable(const DiscountCurve &curve, double step = kDailyStep,
+                   double horizon = 0.0);
+
+  // Refill the table from an updated curve, reusing the existing storage.
+  // Uses a per-segment geometric recurrence (one exp per pillar segment,
+  // plus a periodic resync) so it is cheap enough to run on every update.
+  void rebuild(const DiscountCurve &curve);
+
+  double df(double t) const {
+    if (t <= 0.0)
+      return 1.0;
+    double x = t * invStep_;
+    if (!(x < lastIndex_))
+      return curve_->df(t); // beyond the grid (or NaN, which the curve rejects)
+    auto i = static_cast<std::size_t>(x);
+    double frac = x - static_cast<double>(i);
+    return grid_[i] + frac * (grid_[i + 1] - grid_[i]);
+  }
+
+  // Batched lookup; out must have the same size as times
+  void df(QUANT_SPAN<const double> times, QUANT_SPAN<double> out) const;
+
+  double step() const { return step_; }
+  double horizon() const { return horizon_; }
+  std::size_t size() const { return grid_.size(); }
+
+private:
+  const DiscountCurve *curve_;
+  double step_;
+  double invStep_;
+  double horizon_;
+  double lastIndex_; // grid_.size() - 1 as a double, for the range check
+  std::vector<double> grid_;
+};
+
+} // namespace quant
@@ -14,18 +14,27 @@ namespace quant {
 
 // Flat constructor
 DiscountCurve::DiscountCurve(double flatYield, Compounding cmp, DayCount dc)
-    : y_(flatYield), m_(cmp), dc_(dc) {
+    : y_(flatYield), m_(cmp), logGrowth_(flatYield), dc_(dc) {
   // Validate inputs
   if (std::isnan(flatYield) || std::isinf(flatYield)) {
     throw std::invalid_argument("Invalid yield: must be finite");
   }
+  if (m_ != Compounding::Continuous) {
+    double m = static_cast<double>(m_);
+    if (flatYield <= -m) {
+      throw std::invalid_argument("Invalid yield: 1 + y/m must be positive");
+    }
+    // (1 + y/m)^(-m*t) = exp(-m*ln(1 + y/m)*t): one log per curve, not per df
+    logGrowth_ = m * std::log1p(flatYield / m);
+  }
   // Note: Negative yields are allowed for certain market conditions
   // Empty boot_ vector indicates flat curve
 }
 
 // Boot-strapped constructor
 DiscountCurve::DiscountCurve(QUANT_SPAN<const ZeroQuote> quotes)
-    : y_(0.0), m_(Compounding::Continuous), dc_(DayCount::ACT_365F) {
+    : y_(0.0), m_(Compounding::Continuous), logGrowth_(0.0),
+      dc_(DayCount::ACT_365F) {
   if (quotes.empty()) {
     throw std::invalid_argument(
         "Cannot create bootstrapped curve with empty quotes");
@@ -50,6 +59,18 @@ DiscountCurve::DiscountCurve(QUANT_SPAN<const ZeroQuote> quotes)
   std::sort(
       boot_.begin(), boot_.end(),
       [](const ZeroQuote &a, const ZeroQuote &b) { return a.time < b.time; });
+
+  // Precompute log-linear segment data once so df() needs a single exp
+  times_.reserve(boot_.size());
+  logDfs_.reserve(boot_.size());
+  slopes_.assign(boot_.size(), 0.0);
+  for (std::size_t i = 0; i < boot_.size(); ++i) {
+    times_.push_back(boot_[i].time);
+    logDfs_.push_back(std::log(boot_[i].df));
+    if (i > 0 && times_[i] > times_[i - 1]) {
+      slopes_[i] = (logDfs_[i] - logDfs_[i - 1]) / (times_[i] - times_[i - 1]);
+    }
+  }
 }
 
 double DiscountCurve::df(double t) const {
@@ -59,65 +80,202 @@ double DiscountCurve::df(double t) const {
   }
 
   if (!boot_.empty()) {
-    // Bootstrapped curve - interpolate discount factors
+    // Bootstrapped curve - log-linear interpolation of discount factors
     if (t <= 0.0)
       return 1.0;
-
-    // Find surrounding points
-    auto it = std::lower_bound(
-        boot_.begin(), boot_.end(), ZeroQuote{t, 0.0},
-        [](const ZeroQuote &a, const ZeroQuote &b) { return a.time < b.time; });
-
-    if (it == boot_.begin()) {
-      // Before first point - flat extrapolation
-      return boot_[0].df;
-    } else if (it == boot_.end()) {
-      // After last point - flat extrapolation
-      return boot_.back().df;
-    } else {
-      // Log-linear interpolation of discount factors (preserves positivity)
-      auto prev = it - 1;
-      double t0 = prev->time;
-      double t1 = it->time;
-      double df0 = prev->df;
-      double df1 = it->df;
-
-      // Ensure positive discount factors for log interpolation
-      if (df0 <= 0.0 || df1 <= 0.0) {
-        // Fallback to linear if any DF is non-positive
-        if (t1 == t0) {
-          return df0;
-        }
-        double weight = (t - t0) / (t1 - t0);
-        return df0 + weight * (df1 - df0);
-      }
-
-      // Log-linear: ln(df) interpolated linearly
-      if (t1 == t0) {
-        // Degenerate case: same time points
-        return df0;
-      }
-      double weight = (t - t0) / (t1 - t0);
-      double logDF = std::log(df0) + weight * (std::log(df1) - std::log(df0));
-      return std::exp(logDF);
-    }
+    std::size_t hint = 1;
+    return std::exp(logDfAt(t, hint));
   } else {
     // Flat curve - use analytical formula
     if (t <= 0.0)
       return 1.0;
 
-    if (m_ == Compounding::Continuous) {
-      // P(0,t) = e^(-y*t)
-      return std::exp(-y_ * t);
-    } else {
-      // P(0,t) = (1 + y/m)^(-m*t)
-      double m = static_cast<double>(m_);
-      if (m == 0.0) {
-        // Fallback to continuous (should not happen due to earlier if)
-        return std::exp(-y_ * t);
-      }
-      return std::pow(1.0 + y_ / m, -m * t);
+    // Continuous: P(0,t) = e^(-y*t)
+    // Periodic:   P(0,t) = (1 + y/m)^(-m*t) = e^(-m*ln(1 + y/m)*t)
+    return std::exp(-logGrowth_ * t);
+  }
+}
+
+double DiscountCurve::logDf(double t) const {
+  std::size_t hint = 1;
+  return logDfChecked(t, hint);
+}
+
+void DiscountCurve::df(QUANT_SPAN<const double> times, QUANT_SPAN<double> out,
+                       Precision precision) const {
+  logDf(times, out);
+  if (precision == Precision::Fast) {
+    for (std::size_t i = 0; i < out.size(); ++i) {
+      out[i] = fastmath::exp(out[i]);
+    }
+  } else {
+    for (std::size_t i = 0; i < out.size(); ++i) {
+      out[i] = std::exp(out[i]);
+    }
+  }
+}
+
+void DiscountCurve::logDf(QUANT_SPAN<const double> times,
+                          QUANT_SPAN<double> out) const {
+  if (times.size() != out.size()) {
+    throw std::invalid_argument("Output size must match number of times");
+  }
+
+  std::size_t hint = 1;
+  for (std::size_t i = 0; i < times.size(); ++i) {
+    out[i] = logDfChecked(times[i], hint);
+  }
+}
+
+double DiscountCurve::logDfFlat(double t) const { return -logGrowth_ * t; }
+
+std::size_t DiscountCurve::segmentAt(double t, std::size_t &hint) const {
+  // 0 and n denote the flat extrapolation regions before the first and
+  // after the last pillar
+  const std::size_t n = times_.size();
+  if (t <= times_.front())
+    return 0;
+  if (t > times_.back())
+    return n;
+
+  // Segment i covers (times_[i-1], times_[i]]. Callers sweeping sorted times
+  // pass the previous segment as a hint, so the search is usually O(1).
+  if (hint == 0 || hint >= n || times_[hint - 1] >= t) {
+    hint = static_cast<std::size_t>(
+        std::lower_bound(times_.begin(), times_.end(), t) - times_.begin());
+  } else {
+    while (times_[hint] < t) {
+      ++hint;
+    }
+  }
+  return hint;
+}
+
+double DiscountCurve::logDfAt(double t, std::size_t &hint) const {
+  // Flat extrapolation on both sides (same as the original df semantics)
+  std::size_t i = segmentAt(t, hint);
+  if (i == 0)
+    return logDfs_.front();
+  if (i == times_.size())
+    return logDfs_.back();
+  return logDfs_[i - 1] + slopes_[i] * (t - times_[i - 1]);
+}
+
+double DiscountCurve::logDfChecked(double t, std::size_t &hint) const {
+  if (std::isnan(t) || std::isinf(t)) {
+    throw std::invalid_argument("Time must be finite");
+  }
+  if (t <= 0.0)
+    return 0.0;
+  return boot_.empty() ? logDfFlat(t) : logDfAt(t, hint);
+}
+
+double DiscountCurve::zeroRate(double t) const {
+  if (!(t > 0.0)) {
+    throw std::invalid_argument("Zero rate requires a positive time");
+  }
+  std::size_t hint = 1;
+  return -logDfChecked(t, hint) / t;
+}
+
+double DiscountCurve::forwardRate(double t0, double t1) const {
+  if (!(t1 > t0)) {
+    throw std::invalid_argument("Forward period must have t1 > t0");
+  }
+  std::size_t hint = 1;
+  double logDf0 = logDfChecked(t0, hint);
+  double logDf1 = logDfChecked(t1, hint);
+  // P(t0)/P(t1) - 1 without forming either discount factor
+  return std::expm1(logDf0 - logDf1) / (t1 - t0);
+}
+
+double DiscountCurve::instForward(double t) const {
+  if (std::isnan(t) || std::isinf(t)) {
+    throw std::invalid_argument("Time must be finite");
+  }
+  if (boot_.empty())
+    return logGrowth_;
+  std::size_t hint = 1;
+  return instForwardAt(t, hint);
+}
+
+double DiscountCurve::instForwardAt(double t, std::size_t &hint) const {
+  // Log-linear discount factors have piecewise-constant forwards; the flat
+  // DF extrapolation regions have zero forward rate
+  std::size_t i = segmentAt(t, hint);
+  if (i == 0 || i == times_.size())
+    return 0.0;
+  return -slopes_[i];
+}
+
+void DiscountCurve::zeroRates(QUANT_SPAN<const double> times,
+                              QUANT_SPAN<double> out) const {
+  if (times.size() != out.size()) {
+    throw std::invalid_argument("Output size must match number of times");
+  }
+  std::size_t hint = 1;
+  for (std::size_t i = 0; i < times.size(); ++i) {
+    double t = times[i];
+    if (!(t > 0.0)) {
+      throw std::invalid_argument("Zero rate requires a positive time");
+    }
+    out[i] = -logDfChecked(t, hint) / t;
+  }
+}
+
+void DiscountCurve::forwardRates(QUANT_SPAN<const double> starts,
+                                 QUANT_SPAN<const double> ends,
+                                 QUANT_SPAN<double> out) const {
+  if (starts.size() != ends.size() || starts.size() != out.size()) {
+    throw std::invalid_argument("Output size must match number of periods");
+  }
+  std::size_t startHint = 1;
+  std::size_t endHint = 1;
+  for (std::size_t i = 0; i < starts.size(); ++i) {
+    double t0 = starts[i];
+    double t1 = ends[i];
+    if (!(t1 > t0)) {
+      throw std::invalid_argument("Forward period must have t1 > t0");
+    }
+    double logDf0 = logDfChecked(t0, startHint);
+    double logDf1 = logDfChecked(t1, endHint);
+    out[i] = std::expm1(logDf0 - logDf1) / (t1 - t0);
+  }
+}
+
+void DiscountCurve::forwardRates(QUANT_SPAN<const double> schedule,
+                                 QUANT_SPAN<double> out) const {
+  if (schedule.empty() || out.size() + 1 != schedule.size()) {
+    throw std::invalid_argument(
+        "Output size must be one less than the schedule size");
+  }
+  // Each schedule date is evaluated once and shared by adjacent periods
+  std::size_t hint = 1;
+  double logDfPrev = logDfChecked(schedule[0], hint);
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    double t0 = schedule[i];
+    double t1 = schedule[i + 1];
+    if (!(t1 > t0)) {
+      throw std::invalid_argument("Forward period must have t1 > t0");
+    }
+    double logDfNext = logDfChecked(t1, hint);
+    out[i] = std::expm1(logDfPrev - logDfNext) / (t1 - t0);
+    logDfPrev = logDfNext;
+  }
+}
+
+void DiscountCurve::instForwards(QUANT_SPAN<const double> times,
+                                 QUANT_SPAN<double> out) const {
+  if (times.size() != out.size()) {
+    throw std::invalid_argument("Output size must match number of times");
+  }
+  std::size_t hint = 1;
+  for (std::size_t i = 0; i < times.size(); ++i) {
+    double t = times[i];
+    if (std::isnan(t) || std::isinf(t)) {
+      throw std::invalid_argument("Time must be finite");
     }
+    out[i] = boot_.empty() ? logGrowth_ : instForwardAt(t, hint);
   }
 }
 
@@ -1,7 +1,9 @@
 #pragma once
 #include "DayCount.hpp"
+#include "FastMath.hpp"
 #include <cmath>
 #include <vector>
+#include <version>
 
 // Use std::span when available, fallback to vector view
 #if __cpp_lib_span >= 202002L
@@ -51,12 +53,58 @@ public:
   DiscountCurve(QUANT_SPAN<const ZeroQuote> quotes);
 
   double df(double t) const;           // P(0,t)
+  double logDf(double t) const;        // ln P(0,t), no exp/log on the hot path
   double fwdBondPrice(double t) const; // for option underlying = 1/df
+
+  // Batched evaluation; out must have the same size as times. Sorted times
+  // are swept in one pass over the pillars. Precision::Fast evaluates the
+  // exp with fastmath::exp (relative error < 2e-11).
+  void df(QUANT_SPAN<const double> times, QUANT_SPAN<double> out,
+          Precision precision = kDefaultPrecision) const;
+  void logDf(QUANT_SPAN<const double> times, QUANT_SPAN<double> out) const;
+
+  // Rate queries evaluated directly from the ln(df) segments:
+  // zero rate z(t) = -ln P(0,t)/t (continuously compounded, t > 0),
+  // simple forward F(t0,t1) = (P(0,t0)/P(0,t1) - 1)/(t1 - t0) with a single
+  // expm1, and instantaneous forward f(t) = -d ln P(0,t)/dt, which is
+  // piecewise constant under log-linear interpolation
+  double zeroRate(double t) const;
+  double forwardRate(double t0, double t1) const;
+  double instForward(double t) const;
+
+  void zeroRates(QUANT_SPAN<const double> times, QUANT_SPAN<double> out) const;
+  void forwardRates(QUANT_SPAN<const double> starts,
+                    QUANT_SPAN<const double> ends,
+                    QUANT_SPAN<double> out) const;
+  // Forwards over consecutive schedule periods [s_i, s_{i+1}]; out has one
+  // element fewer than schedule and each date is evaluated once
+  void forwardRates(QUANT_SPAN<const double> schedule,
+                    QUANT_SPAN<double> out) const;
+  void instForwards(QUANT_SPAN<const double> times,
+                    QUANT_SPAN<double> out) const;
+
+  // Curve shape accessors (pillars are empty for a flat curve)
+  bool isFlat() const { return boot_.empty(); }
+  const std::vector<ZeroQuote> &pillars() const { return boot_; }
+
 private:
   double y_;
   Compounding m_;
+  double logGrowth_; // flat curves: ln P(0,t) = -logGrowth_ * t
   [[maybe_unused]] DayCount dc_;
   std::vector<ZeroQuote> boot_;
+
+  // Log-linear interpolation data precomputed from boot_: pillar times,
+  // ln(df) at each pillar and the ln(df) slope of the segment ending there
+  std::vector<double> times_;
+  std::vector<double> logDfs_;
+  std::vector<double> slopes_;
+
+  double logDfFlat(double t) const;
+  std::size_t segmentAt(double t, std::size_t &hint) const;
+  double logDfAt(double t, std::size_t &hint) const;
+  double logDfChecked(double t, std::size_t &hint) const;
+  double instForwardAt(double t, std::size_t &hint) const;
 };
 
 } // namespace quant
\ No newline at end of file
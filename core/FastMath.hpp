@@ -0,0 +1,235 @@
+#pragma once
+#include <bit>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace quant {
+
+// Accuracy tier for batched kernels. Exact uses the C library; Fast uses
+// the polynomial approximations below, for consumers that only need about
+// 1e-7 relative accuracy (screen pricing, scenario pre-screens).
+enum class Precision { Exact, Fast };
+
+// Build with -DQUANT_FAST_MATH=ON to make Fast the default for every
+// kernel that takes a Precision argument
+#if defined(QUANT_FAST_MATH) && QUANT_FAST_MATH
+inline constexpr Precision kDefaultPrecision = Precision::Fast;
+#else
+inline constexpr Precision kDefaultPrecision = Precision::Exact;
+#endif
+
+inline constexpr double kPi = 3.14159265358979323846;
+
+// Straight-line approximations written so that loops over them
+// auto-vectorize with the default flags (-O3, SSE2, -ftrapping-math):
+//   - no library calls, and integers move through the mantissa of a
+//     1.5 * 2^52 bias instead of double <-> int64 conversions, which SSE2
+//     lacks;
+//   - out-of-range arguments are replaced by detail::substitute rather than
+//     a constant, or the compiler threads the constant through the
+//     polynomial and leaves a branch behind;
+//   - results are combined with blend() or multiplied by a selected
+//     constant, never picked by a select whose arms hold arithmetic: the
+//     compiler sinks such arithmetic into a branch and, since it may trap,
+//     refuses to if-convert it again.
+// Special inputs (NaN, infinities, out-of-range) run through the kernel on
+// a clamped argument and are patched in at the end. Error bounds are
+// measured by tests/fastmath_test.cpp over each kernel's whole domain;
+// benchmarkFastMath in curve_demo compares both tiers.
+namespace fastmath {
+
+namespace detail {
+
+inline constexpr double kRound = 6755399441055744.0; // 1.5 * 2^52
+
+// Bits of x rounded to an integer n, |n| < 2^51, when added to kRound: the
+// low mantissa bits then hold 2^51 + n
+inline std::uint64_t roundedBits(double x) {
+  return std::bit_cast<std::uint64_t>(x + kRound);
+}
+
+// c ? a : b for finite a and b, exact up to the sign of zero. Both sides
+// are weighted by 0 or 2, neither of which the compiler may fold away.
+inline double blend(bool c, double a, double b) {
+  const double wa = c ? 2.0 : 0.0;
+  const double wb = c ? 0.0 : 2.0;
+  return 0.5 * (a * wa + b * wb);
+}
+
+// A value in [base, 2 base) taken from the mantissa of x, base a positive
+// power of two. Clamped lanes use it instead of a constant, which the
+// compiler would fold (std::copysign of a constant too, once squared).
+inline double substitute(double x, double base) {
+  return std::bit_cast<double>(
+      (std::bit_cast<std::uint64_t>(x) & 0x000fffffffffffffULL) |
+      std::bit_cast<std::uint64_t>(base));
+}
+
+// 0 for numbers, NaN for NaN; added to a result to propagate NaN inputs
+inline double nanOf(double x) {
+  return x == x ? 0.0 : std::numeric_limits<double>::quiet_NaN();
+}
+
+} // namespace detail
+
+// e^x with relative error < 2e-11 for x in [-708, 709.78]. Range reduction
+// x = k ln2 + r with |r| <= ln2/2, degree-9 Taylor polynomial for e^r and
+// 2^(k-1) assembled in the exponent bits (the final factor 2 lets k = 1024
+// through without a special path). Returns 0 below -708 (no subnormals),
+// +inf above 709.78 and NaN for NaN.
+inline double exp(double x) {
+  constexpr double kLog2e = 1.4426950408889634;
+  constexpr double kLn2Hi = 6.93147180369123816490e-01;
+  constexpr double kLn2Lo = 1.90821492927058770002e-10;
+  constexpr double kMin = -708.0;
+  constexpr double kMax = 709.782712893384;
+
+  // Out-of-range and NaN lanes compute e^[1, 2), patched by the factor
+  const double lo = x >= kMin ? x : detail::substitute(x, 1.0);
+  const double xc = lo <= kMax ? lo : detail::substitute(x, 1.0);
+
+  const std::uint64_t kBits = detail::roundedBits(xc * kLog2e);
+  const double kf = std::bit_cast<double>(kBits) - detail::kRound;
+  const double r = (xc - kf * kLn2Hi) - kf * kLn2Lo;
+
+  double p = 1.0 / 362880.0;
+  p = p * r + 1.0 / 40320.0;
+  p = p * r + 1.0 / 5040.0;
+  p = p * r + 1.0 / 720.0;
+  p = p * r + 1.0 / 120.0;
+  p = p * r + 1.0 / 24.0;
+  p = p * r + 1.0 / 6.0;
+  p = p * r + 0.5;
+  p = p * r + 1.0;
+  p = p * r + 1.0;
+
+  // (2^51 + k + 1022) << 52 keeps only k + 1022 in the exponent field
+  const double halfScale = std::bit_cast<double>((kBits + 1022) << 52);
+  const double factor = x < kMin ? 0.0 : (x > kMax ? HUGE_VAL : 2.0);
+  return p * halfScale * factor + detail::nanOf(x);
+}
+
+// Natural log with absolute error < 1e-12 (relative < 3e-12) for positive
+// finite doubles, subnormals included (pre-scaled by 2^52). x = m 2^e with
+// m in [sqrt(1/2), sqrt(2)) (the exponent split is biased so no select is
+// needed for the upper half), and ln m = 2 atanh(s), s = (m-1)/(m+1),
+// |s| < 0.172, by its odd series to s^13. Returns -inf for zero, +inf for
+// +inf and NaN for negative or NaN inputs.
+inline double log(double x) {
+  constexpr double kLn2 = 0.6931471805599453;
+  constexpr double kTwo52 = 4503599627370496.0;
+  constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+  constexpr std::uint64_t kSqrtHalf = 0x3fe6a09e667f3bcdULL; // bits of √½
+  constexpr std::uint64_t kMantissa = 0x000fffffffffffffULL;
+
+  // Testing the scaled value keeps it out of a branch of its own; the
+  // exponent offset tests x so the two selects do not share a condition
+  const double scaled = x * kTwo52;
+  const double xs = scaled < DBL_MIN * kTwo52 ? scaled : x;
+  const double offset = x < DBL_MIN ? 1075.0 : 1023.0;
+
+  // Shifting by 1 - √½ in the bits carries mantissas above √2 into the
+  // exponent; the exponent field is converted through the mantissa of 2^52.
+  // The sign bit of a negative input only makes the discarded result junk.
+  const auto bits =
+      std::bit_cast<std::uint64_t>(xs) + (0x3ff0000000000000ULL - kSqrtHalf);
+  const double biased =
+      std::bit_cast<double>((bits >> 52) | 0x4330000000000000ULL) - kTwo52;
+  const double m = std::bit_cast<double>((bits & kMantissa) + kSqrtHalf);
+  const double e = biased - offset;
+
+  const double s = (m - 1.0) / (m + 1.0);
+  const double s2 = s * s;
+  double p = 2.0 / 13.0;
+  p = p * s2 + 2.0 / 11.0;
+  p = p * s2 + 2.0 / 9.0;
+  p = p * s2 + 2.0 / 7.0;
+  p = p * s2 + 2.0 / 5.0;
+  p = p * s2 + 2.0 / 3.0;
+  p = p * s2 + 2.0;
+  const double result = e * kLn2 + s * p; // finite for every input
+
+  const double special =
+      x > DBL_MAX ? HUGE_VAL
+                  : (x > 0.0 ? 0.0 : (x == 0.0 ? -HUGE_VAL : kNaN));
+  return result + special;
+}
+
+// 1/sqrt(x) with relative error < 1e-15 for positive normal x: the
+// bit-shift estimate (within 3.5%) refined by four Newton steps, each of
+// which squares the error. Unlike std::sqrt, which may set errno, it stays
+// inline in a vectorized loop.
+inline double rsqrt(double x) {
+  const double half = 0.5 * x;
+  double y = std::bit_cast<double>(0x5fe6eb50c7b537a9ULL -
+                                   (std::bit_cast<std::uint64_t>(x) >> 1));
+  y = y * (1.5 - half * y * y);
+  y = y * (1.5 - half * y * y);
+  y = y * (1.5 - half * y * y);
+  y = y * (1.5 - half * y * y);
+  return y;
+}
+
+// Standard normal CDF with relative error < 1e-7 on the whole real line
+// (both tails), from W. J. Cody's rational Chebyshev approximation for the
+// intermediate range (Math. Comp. 1969; ANORM in SPECFUN) with the fast
+// exp above:
+//   N(-|x|) = e^{-x²/2} R2(|x|)
+// Cody fits R2 on 0.66291 <= |x| <= √32 and switches to other forms
+// outside it. At this tier's accuracy one rational is enough: measured
+// against erfc, R2 stays within 5e-12 relative down to zero and within
+// 8e-8 out to |x| = 37.6, where e^{-x²/2} underflows. One rational, one
+// exp and one division keep a vector lane cheap. e^{-x²/2} is taken
+// directly; rounding in x² costs at most 1e-13 relative there.
+inline double normCDF(double x) {
+  const double y = std::abs(x);
+  const double gauss = fastmath::exp(-0.5 * y * y);
+
+  // Lanes beyond 40, where gauss has underflowed, and NaN use y in [1, 2)
+  const double t = y < 40.0 ? y : detail::substitute(x, 1.0);
+  double cn = 1.0765576773720192317e-8 * t;
+  double cd = t;
+  cn = (cn + 3.9894151208813466764e-1) * t;
+  cd = (cd + 2.2266688044328115691e01) * t;
+  cn = (cn + 8.8831497943883759412e00) * t;
+  cd = (cd + 2.3538790178262499861e02) * t;
+  cn = (cn + 9.3506656132177855979e01) * t;
+  cd = (cd + 1.5193775994075548050e03) * t;
+  cn = (cn + 5.9727027639480026226e02) * t;
+  cd = (cd + 6.4855582982667607550e03) * t;
+  cn = (cn + 2.4945375852903726711e03) * t;
+  cd = (cd + 1.8615571640885098091e04) * t;
+  cn = (cn + 6.8481904505362823326e03) * t;
+  cd = (cd + 3.4900952721145977266e04) * t;
+  cn = (cn + 1.1602651437647350124e04) * t;
+  cd = (cd + 3.8912003286093271411e04) * t;
+  cn += 9.8427148383839780218e03;
+  cd += 1.9685429676859990727e04;
+
+  // N(-|x|) = lower / cd and N(|x|) = (cd - lower) / cd
+  const double lower = gauss * cn;
+  const double num = detail::blend(x > 0.0, cd - lower, lower);
+  return num / cd + detail::nanOf(x);
+}
+
+} // namespace fastmath
+
+// Per-call dispatch between the two tiers
+inline double mathExp(double x, Precision p) {
+  return p == Precision::Fast ? fastmath::exp(x) : std::exp(x);
+}
+
+inline double mathLog(double x, Precision p) {
+  return p == Precision::Fast ? fastmath::log(x) : std::log(x);
+}
+
+// Exact is the erf form used by Black76::normCDF, so batched kernels match
+// the scalar pricers
+inline double mathNormCDF(double x, Precision p) {
+  return p == Precision::Fast ? fastmath::normCDF(x)
+                              : 0.5 * (1.0 + std::erf(x / std::sqrt(2.0)));
+}
+
+} // namespace quant
@@ -0,0 +1,216 @@
+#include "HazardCurve.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace quant {
+
+namespace {
+
+const double kTolerance = 1e-14;
+const int kMaxIterations = 200;
+const double kMaxHazard = 50.0;
+
+void checkRecovery(double recovery) {
+  if (!(recovery >= 0.0) || !(recovery < 1.0)) {
+    throw std::invalid_argument("Recovery rate must be in [0, 1)");
+  }
+}
+
+} // namespace
+
+HazardCurve::HazardCurve(std::vector<double> times, std::vector<double> hazards)
+    : times_(std::move(times)), hazards_(std::move(hazards)) {
+  if (times_.empty() || times_.size() != hazards_.size()) {
+    throw std::invalid_argument(
+        "Hazard curve needs one hazard rate per pillar");
+  }
+  for (std::size_t i = 0; i < times_.size(); ++i) {
+    if (!(times_[i] > (i == 0 ? 0.0 : times_[i - 1])) ||
+        std::isinf(times_[i])) {
+      throw std::invalid_argument(
+          "Hazard pillars must be positive, finite and strictly increasing");
+    }
+    if (!(hazards_[i] >= 0.0) || std::isinf(hazards_[i])) {
+      throw std::invalid_argument("Hazard rates must be non-negative");
+    }
+  }
+  buildCumulative();
+}
+
+void HazardCurve::buildCumulative() {
+  cumulative_.resize(times_.size());
+  double lambda = 0.0;
+  double previous = 0.0;
+  for (std::size_t i = 0; i < times_.size(); ++i) {
+    lambda += hazards_[i] * (times_[i] - previous);
+    cumulative_[i] = lambda;
+    previous = times_[i];
+  }
+}
+
+HazardCurve HazardCurve::flat(double hazard) {
+  return HazardCurve({1.0}, {hazard});
+}
+
+HazardCurve HazardCurve::fromSpreads(QUANT_SPAN<const double> times,
+                                     QUANT_SPAN<const double> spreads,
+                                     double recovery) {
+  checkRecovery(recovery);
+  if (times.size() != spreads.size()) {
+    throw std::invalid_argument("Need one spread per pillar");
+  }
+  std::vector<double> t(times.begin(), times.end());
+  std::vector<double> hazards(t.size());
+  double previousLambda = 0.0;
+  double previousTime = 0.0;
+  for (std::size_t i = 0; i < t.size(); ++i) {
+    double lambda = spreads[i] / (1.0 - recovery) * t[i];
+    hazards[i] =
+        std::max(0.0, (lambda - previousLambda) / (t[i] - previousTime));
+    previousLambda = std::max(lambda, previousLambda);
+    previousTime = t[i];
+  }
+  return HazardCurve(std::move(t), std::move(hazards));
+}
+
+double HazardCurve::survival(double t) const {
+  if (t <= 0.0)
+    return 1.0;
+  auto it = std::lower_bound(times_.begin(), times_.end(), t);
+  std::size_t i = static_cast<std::size_t>(it - times_.begin());
+  if (i == times_.size()) {
+    return std::exp(
+        -(cumulative_.back() + hazards_.back() * (t - times_.back())));
+  }
+  // Inside segment i: Λ(t) = Λ(t_i) - λ_i (t_i - t)
+  return std::exp(-(cumulative_[i] - hazards_[i] * (times_[i] - t)));
+}
+
+double HazardCurve::hazard(double t) const {
+  auto it = std::lower_bound(times_.begin(), times_.end(), t);
+  return it == times_.end() ? hazards_.back()
+                            : hazards_[static_cast<std::size_t>(
+                                  it - times_.begin())];
+}
+
+void HazardCurve::survival(QUANT_SPAN<const double> times,
+                           QUANT_SPAN<double> out) const {
+  if (times.size() != out.size()) {
+    throw std::invalid_argument("Output size must match number of times");
+  }
+  // Walk the pillars alongside sorted times; fall back to lookups otherwise
+  std::size_t i = 0;
+  double previous = 0.0;
+  for (std::size_t k = 0; k < times.size(); ++k) {
+    const double t = times[k];
+    if (t < previous) {
+      for (std::size_t j = k; j < times.size(); ++j) {
+        out[j] = survival(times[j]);
+      }
+      return;
+    }
+    previous = t;
+    while (i < times_.size() && times_[i] < t) {
+      ++i;
+    }
+    if (t <= 0.0) {
+      out[k] = 1.0;
+    } else if (i == times_.size()) {
+      out[k] = std::exp(
+          -(cumulative_.back() + hazards_.back() * (t - times_.back())));
+    } else {
+      out[k] = std::exp(-(cumulative_[i] - hazards_[i] * (times_[i] - t)));
+    }
+  }
+}
+
+double HazardCurve::cdsParSpread(const DiscountCurve &base, double maturity,
+                                 int frequency, double recovery) const {
+  if (frequency <= 0 || !(maturity > 0.0)) {
+    throw std::invalid_argument("Invalid CDS maturity or frequency");
+  }
+  const long periods =
+      std::max(1L, std::lround(std::ceil(maturity * frequency - 1e-9)));
+  const double tau = maturity / static_cast<double>(periods);
+
+  double annuity = 0.0;
+  double protection = 0.0;
+  double sPrev = 1.0;
+  for (long j = 1; j <= periods; ++j) {
+    const double t = j * tau;
+    const double df = base.df(t);
+    const double s = survival(t);
+    const double defaulted = sPrev - s;
+    annuity += tau * df * (s + 0.5 * defaulted);
+    protection += df * defaulted;
+    sPrev = s;
+  }
+  return annuity > 0.0 ? (1.0 - recovery) * protection / annuity : 0.0;
+}
+
+HazardCurve HazardCurve::bootstrap(const DiscountCurve &base,
+                                   QUANT_SPAN<const CdsQuote> quotes,
+                                   double recovery) {
+  checkRecovery(recovery);
+  if (quotes.empty()) {
+    throw std::invalid_argument("Cannot bootstrap a hazard curve without "
+                                "quotes");
+  }
+  std::vector<double> times;
+  std::vector<double> hazards;
+  for (const CdsQuote &q : quotes) {
+    if (!(q.maturity > (times.empty() ? 0.0 : times.back()))) {
+      throw std::invalid_argument(
+          "CDS maturities must be positive and strictly increasing");
+    }
+    if (!(q.spread >= 0.0) || std::isinf(q.spread)) {
+      throw std::invalid_argument("CDS spreads must be non-negative");
+    }
+    times.push_back(q.maturity);
+
+    // The par spread rises monotonically with the last hazard, so the quote
+    // is bracketed iff kMaxHazard reaches it; otherwise bisection would
+    // settle on kMaxHazard with the wrong spread
+    hazards.push_back(kMaxHazard);
+    if (HazardCurve(times, hazards).cdsParSpread(base, q.maturity, q.frequency,
+                                                 recovery) < q.spread) {
+      throw std::runtime_error(
+          "HazardCurve: CDS spread at " + std::to_string(q.maturity) +
+          " needs a hazard rate above " + std::to_string(kMaxHazard));
+    }
+    // Credit-triangle guess
+    hazards.back() = std::min(q.spread / (1.0 - recovery), kMaxHazard);
+
+    // Bisect
+    double lo = 0.0;
+    double hi = kMaxHazard;
+    bool converged = false;
+    for (int iter = 0; iter < kMaxIterations; ++iter) {
+      HazardCurve trial(times, hazards);
+      double diff = trial.cdsParSpread(base, q.maturity, q.frequency,
+                                       recovery) -
+                    q.spread;
+      if (std::abs(diff) < kTolerance) {
+        converged = true;
+        break;
+      }
+      (diff > 0.0 ? hi : lo) = hazards.back();
+      hazards.back() = 0.5 * (lo + hi);
+      if (hi - lo < kTolerance) {
+        converged = true;
+        break;
+      }
+    }
+    if (!converged) {
+      throw std::runtime_error(
+          "HazardCurve: CDS pillar did not converge at " +
+          std::to_string(q.maturity));
+    }
+  }
+  return HazardCurve(std::move(times), std::move(hazards));
+}
+
+} // namespace quant
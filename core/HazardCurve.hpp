@@ -0,0 +1,63 @@
+#pragma once
+#include "DiscountCurve.hpp"
+#include <vector>
+
+namespace quant {
+
+struct CdsQuote {
+  double maturity;   // years
+  double spread;     // running par spread, e.g. 0.01 for 100bp
+  int frequency = 4; // premium payments per year
+};
+
+// Survival-probability curve with piecewise-constant hazard rates:
+//   S(t) = exp(-Λ(t)),  Λ(t) = ∫₀ᵗ λ(u) du
+// with λ = hazards[i] on (times[i-1], times[i]] (times[-1] = 0) and the last
+// hazard extrapolated flat. Λ is stored at the pillars, so S(t) is one
+// lookup plus one exp, and a sorted batch of times is evaluated in a single
+// sweep that walks the pillars alongside the times.
+class HazardCurve {
+public:
+  // times strictly increasing and positive, hazards non-negative
+  HazardCurve(std::vector<double> times, std::vector<double> hazards);
+
+  static HazardCurve flat(double hazard);
+
+  // Credit triangle per pillar: average hazard s_k / (1 - R) up to t_k,
+  // e.g. from bond credit spreads; forward hazards are floored at zero
+  static HazardCurve fromSpreads(QUANT_SPAN<const double> times,
+                                 QUANT_SPAN<const double> spreads,
+                                 double recovery);
+
+  // Sequential bootstrap so each CDS reprices at its par spread against
+  // the base discount curve (quotes with increasing maturities). A quote
+  // that would need a negative forward hazard gets a zero hazard instead;
+  // one that would need a hazard above 50 throws std::runtime_error.
+  static HazardCurve bootstrap(const DiscountCurve &base,
+                               QUANT_SPAN<const CdsQuote> quotes,
+                               double recovery);
+
+  double survival(double t) const;
+  double hazard(double t) const;
+
+  // Batched evaluation; a single merged sweep when times are sorted
+  void survival(QUANT_SPAN<const double> times, QUANT_SPAN<double> out) const;
+
+  // Par spread of a CDS starting today: protection leg / risky annuity.
+  // Premium accrued to the default time is included, default is settled
+  // at the end of the premium period it falls in.
+  double cdsParSpread(const DiscountCurve &base, double maturity,
+                      int frequency, double recovery) const;
+
+  const std::vector<double> &times() const { return times_; }
+  const std::vector<double> &hazards() const { return hazards_; }
+
+private:
+  std::vector<double> times_;
+  std::vector<double> hazards_;
+  std::vector<double> cumulative_; // Λ(times_[i])
+
+  void buildCumulative();
+};
+
+} // namespace quant
@@ -0,0 +1,268 @@
+#include "HugePages.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace quant {
+
+namespace {
+
+constexpr std::size_t kHugePageSize = std::size_t{2} << 20;
+
+std::atomic<HugePagePolicy> gPolicy{HugePagePolicy::Off};
+std::atomic<std::size_t> gThreshold{kHugePageSize};
+// Lowest threshold ever set: anything at least this large may be tracked
+std::atomic<std::size_t> gLowestThreshold{kHugePageSize};
+
+struct Allocation {
+  const char *tag;
+  std::size_t bytes;
+  PageBacking backing;
+  void *mapping; // start of the mmap region (may precede the buffer)
+  std::size_t mappedBytes;
+};
+
+// Large allocations only, so a mutex-protected map is cheap enough
+std::mutex gMutex;
+std::unordered_map<void *, Allocation> &liveAllocations() {
+  static std::unordered_map<void *, Allocation> live;
+  return live;
+}
+
+std::size_t roundUp(std::size_t bytes, std::size_t to) {
+  return (bytes + to - 1) / to * to;
+}
+
+#if defined(__linux__)
+// False when /sys/kernel/mm/transparent_hugepage/enabled is "[never]": the
+// advice would be accepted but never acted on
+bool transparentEnabled() {
+  static const bool enabled = [] {
+    std::ifstream in("/sys/kernel/mm/transparent_hugepage/enabled");
+    std::string mode;
+    std::getline(in, mode);
+    return mode.find("[never]") == std::string::npos;
+  }();
+  return enabled;
+}
+
+bool mapExplicit(std::size_t bytes, Allocation &a) {
+  std::size_t size = roundUp(bytes, kHugePageSize);
+  void *p = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  if (p == MAP_FAILED)
+    return false;
+  a = {nullptr, bytes, PageBacking::Explicit, p, size};
+  return true;
+}
+
+// Over-map by one huge page so the buffer can start on a 2 MB boundary,
+// then trim the slack so the kernel can use whole huge pages
+void *mapTransparent(std::size_t bytes, Allocation &a) {
+  std::size_t size = roundUp(bytes, kHugePageSize);
+  std::size_t mapped = size + kHugePageSize;
+  void *raw = mmap(nullptr, mapped, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (raw == MAP_FAILED)
+    return nullptr;
+
+  auto start = reinterpret_cast<std::uintptr_t>(raw);
+  auto aligned = roundUp(start, kHugePageSize);
+  if (aligned > start) {
+    munmap(raw, aligned - start);
+  }
+  std::size_t tail = start + mapped - (aligned + size);
+  if (tail > 0) {
+    munmap(reinterpret_cast<void *>(aligned + size), tail);
+  }
+
+  // Advice only: whether the kernel honours it is checked in the report
+  void *p = reinterpret_cast<void *>(aligned);
+  bool advised = transparentEnabled() && madvise(p, size, MADV_HUGEPAGE) == 0;
+  a = {nullptr, bytes,
+       advised ? PageBacking::Transparent : PageBacking::Regular, p, size};
+  return p;
+}
+
+// Mapping [start, end) and its AnonHugePages from /proc/self/smaps
+struct SmapsRange {
+  std::uintptr_t start, end;
+  std::size_t anonHugeBytes;
+};
+
+std::vector<SmapsRange> readSmaps() {
+  std::vector<SmapsRange> ranges;
+  std::ifstream in("/proc/self/smaps");
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.rfind("AnonHugePages:", 0) == 0) {
+      if (!ranges.empty()) {
+        ranges.back().anonHugeBytes =
+            std::strtoull(line.c_str() + 14, nullptr, 10) * 1024;
+      }
+      continue;
+    }
+    // Mapping headers start with "start-end"; field lines with a name
+    char *dash = nullptr;
+    std::uintptr_t start = std::strtoull(line.c_str(), &dash, 16);
+    if (dash == line.c_str() || *dash != '-')
+      continue;
+    char *rest = nullptr;
+    std::uintptr_t end = std::strtoull(dash + 1, &rest, 16);
+    if (*rest == ' ')
+      ranges.push_back({start, end, 0});
+  }
+  return ranges;
+}
+
+// Huge-page bytes of the mappings overlapping a buffer. Adjacent mappings
+// with identical flags are merged by the kernel, so the sum is capped at
+// the buffer's own mapped size.
+std::size_t hugeBytesIn(const std::vector<SmapsRange> &ranges,
+                        const Allocation &a) {
+  auto begin = reinterpret_cast<std::uintptr_t>(a.mapping);
+  std::uintptr_t end = begin + a.mappedBytes;
+  std::size_t total = 0;
+  for (const SmapsRange &r : ranges) {
+    if (r.start < end && begin < r.end)
+      total += r.anonHugeBytes;
+  }
+  return std::min(total, a.mappedBytes);
+}
+#endif
+
+} // namespace
+
+void setHugePagePolicy(HugePagePolicy policy) { gPolicy.store(policy); }
+HugePagePolicy hugePagePolicy() { return gPolicy.load(); }
+void setHugePageThreshold(std::size_t bytes) {
+  gThreshold.store(bytes);
+  std::size_t lowest = gLowestThreshold.load();
+  while (bytes < lowest &&
+         !gLowestThreshold.compare_exchange_weak(lowest, bytes)) {
+  }
+}
+std::size_t hugePageThreshold() { return gThreshold.load(); }
+
+void *hugePageAllocate(std::size_t bytes, const char *tag) {
+  if (bytes < gThreshold.load()) {
+    return ::operator new(bytes == 0 ? 1 : bytes);
+  }
+
+  Allocation a{tag, bytes, PageBacking::Regular, nullptr, 0};
+  void *p = nullptr;
+#if defined(__linux__)
+  HugePagePolicy policy = gPolicy.load();
+  if (policy == HugePagePolicy::Explicit && mapExplicit(bytes, a)) {
+    p = a.mapping;
+  } else if (policy != HugePagePolicy::Off) {
+    p = mapTransparent(bytes, a);
+  }
+  a.tag = tag;
+#endif
+  if (p == nullptr) {
+    p = ::operator new(bytes);
+    a = {tag, bytes, PageBacking::Regular, nullptr, 0};
+  }
+
+  std::lock_guard<std::mutex> lock(gMutex);
+  liveAllocations().emplace(p, a);
+  return p;
+}
+
+void hugePageDeallocate(void *p, std::size_t bytes) noexcept {
+  if (p == nullptr)
+    return;
+  if (bytes >= gLowestThreshold.load()) {
+    std::unique_lock<std::mutex> lock(gMutex);
+    auto &live = liveAllocations();
+    auto it = live.find(p);
+    if (it != live.end()) {
+      Allocation a = it->second;
+      live.erase(it);
+      lock.unlock();
+#if defined(__linux__)
+      if (a.mapping != nullptr) {
+        munmap(a.mapping, a.mappedBytes);
+        return;
+      }
+#endif
+      ::operator delete(p);
+      return;
+    }
+  }
+  ::operator delete(p);
+}
+
+std::vector<HugePageRecord> hugePageReport() {
+  std::vector<Allocation> live;
+  {
+    std::lock_guard<std::mutex> lock(gMutex);
+    for (const auto &[p, a] : liveAllocations()) {
+      live.push_back(a);
+    }
+  }
+
+#if defined(__linux__)
+  std::vector<SmapsRange> ranges;
+  if (std::any_of(live.begin(), live.end(), [](const Allocation &a) {
+        return a.backing == PageBacking::Transparent;
+      })) {
+    ranges = readSmaps();
+  }
+#endif
+
+  std::vector<HugePageRecord> report;
+  for (const Allocation &a : live) {
+    HugePageRecord r{a.tag, a.bytes, a.backing, 0};
+    if (a.backing == PageBacking::Explicit) {
+      r.hugeBytes = a.mappedBytes;
+    }
+#if defined(__linux__)
+    if (a.backing == PageBacking::Transparent) {
+      r.hugeBytes = hugeBytesIn(ranges, a);
+      if (r.hugeBytes == 0)
+        r.backing = PageBacking::Regular;
+    }
+#endif
+    report.push_back(std::move(r));
+  }
+  return report;
+}
+
+const char *toString(PageBacking backing) {
+  switch (backing) {
+  case PageBacking::Transparent:
+    return "transparent huge pages";
+  case PageBacking::Explicit:
+    return "explicit huge pages";
+  default:
+    return "regular pages";
+  }
+}
+
+void printHugePageReport(std::ostream &os) {
+  auto report = hugePageReport();
+  os << "Large buffers (>= " << hugePageThreshold() / 1024 << " KB): "
+     << report.size() << "\n";
+  for (const auto &r : report) {
+    os << "  " << std::left << std::setw(28) << r.tag << std::right
+       << std::setw(10) << r.bytes / 1024 << " KB  " << toString(r.backing);
+    if (r.backing == PageBacking::Transparent) {
+      os << " (" << r.hugeBytes / 1024 << " KB huge)";
+    }
+    os << "\n";
+  }
+}
+
+} // namespace quant
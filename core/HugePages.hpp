@@ -0,0 +1,87 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace quant {
+
+// How large buffers are backed
+enum class HugePagePolicy {
+  Off,         // plain operator new
+  Transparent, // 2 MB aligned anonymous mapping + madvise(MADV_HUGEPAGE)
+  Explicit     // MAP_HUGETLB from the reserved pool, else Transparent
+};
+
+enum class PageBacking { Regular, Transparent, Explicit };
+
+// Process-wide settings. The policy defaults to Off, so huge pages are only
+// used once a caller opts in. Buffers below the threshold (default 2 MB)
+// always use operator new. On non-Linux systems every buffer is Regular.
+void setHugePagePolicy(HugePagePolicy policy);
+HugePagePolicy hugePagePolicy();
+void setHugePageThreshold(std::size_t bytes);
+std::size_t hugePageThreshold();
+
+// Allocate/free a buffer according to the current policy. Buffers at or
+// above the threshold are tracked under their tag until freed.
+void *hugePageAllocate(std::size_t bytes, const char *tag);
+void hugePageDeallocate(void *p, std::size_t bytes) noexcept;
+
+// A large buffer that is currently allocated. Transparent huge pages are
+// only advice, so for those buffers the backing is read back from the
+// kernel (AnonHugePages in /proc/self/smaps) when the report is taken:
+// Transparent means at least part of the touched range is on huge pages.
+// Pages are populated on first touch, so an untouched buffer is Regular.
+struct HugePageRecord {
+  std::string tag;
+  std::size_t bytes;
+  PageBacking backing;
+  std::size_t hugeBytes; // bytes currently backed by huge pages
+};
+
+std::vector<HugePageRecord> hugePageReport();
+void printHugePageReport(std::ostream &os);
+const char *toString(PageBacking backing);
+
+// Standard allocator routing through hugePageAllocate, for
+// std::vector<T, HugePageAllocator<T>>. The tag names the buffer in
+// hugePageReport() and must be a string literal (it is not copied).
+template <typename T> class HugePageAllocator {
+public:
+  using value_type = T;
+
+  explicit HugePageAllocator(const char *tag = "unnamed") noexcept
+      : tag_(tag) {}
+  template <typename U>
+  HugePageAllocator(const HugePageAllocator<U> &other) noexcept
+      : tag_(other.tag()) {}
+
+  T *allocate(std::size_t n) {
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                  "Over-aligned types are not supported");
+    if (n > static_cast<std::size_t>(-1) / sizeof(T))
+      throw std::bad_array_new_length();
+    return static_cast<T *>(hugePageAllocate(n * sizeof(T), tag_));
+  }
+  void deallocate(T *p, std::size_t n) noexcept {
+    hugePageDeallocate(p, n * sizeof(T));
+  }
+
+  const char *tag() const noexcept { return tag_; }
+
+  template <typename U>
+  bool operator==(const HugePageAllocator<U> &) const noexcept {
+    return true; // any instance can free memory from any other
+  }
+
+private:
+  const char *tag_;
+};
+
+template <typename T>
+using HugePageVector = std::vector<T, HugePageAllocator<T>>;
+
+} // namespace quant
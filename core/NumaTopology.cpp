@@ -0,0 +1,117 @@
+#include "NumaTopology.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace quant {
+
+NumaTopology::NumaTopology(std::vector<NumaNode> nodes)
+    : nodes_(std::move(nodes)) {
+  if (nodes_.empty()) {
+    throw std::invalid_argument("NUMA topology needs at least one node");
+  }
+  for (const auto &node : nodes_) {
+    if (node.cpus.empty()) {
+      throw std::invalid_argument("NUMA node without CPUs: " +
+                                  std::to_string(node.id));
+    }
+  }
+}
+
+NumaTopology NumaTopology::singleNode() {
+  unsigned hw = std::thread::hardware_concurrency();
+  NumaNode node{0, {}};
+  for (unsigned cpu = 0; cpu < std::max(hw, 1u); ++cpu) {
+    node.cpus.push_back(static_cast<int>(cpu));
+  }
+  return NumaTopology({node});
+}
+
+NumaTopology NumaTopology::detect() {
+  namespace fs = std::filesystem;
+  const fs::path root("/sys/devices/system/node");
+
+  std::vector<NumaNode> nodes;
+  std::error_code ec;
+  for (const auto &entry : fs::directory_iterator(root, ec)) {
+    const std::string name = entry.path().filename().string();
+    if (name.rfind("node", 0) != 0 || name.size() == 4 ||
+        !std::all_of(name.begin() + 4, name.end(), ::isdigit)) {
+      continue;
+    }
+    std::ifstream in(entry.path() / "cpulist");
+    std::string list;
+    if (!in || !std::getline(in, list))
+      continue;
+
+    NumaNode node{std::stoi(name.substr(4)), parseCpuList(list)};
+    if (!node.cpus.empty())
+      nodes.push_back(std::move(node));
+  }
+
+  if (ec || nodes.empty())
+    return singleNode();
+
+  std::sort(nodes.begin(), nodes.end(),
+            [](const NumaNode &a, const NumaNode &b) { return a.id < b.id; });
+  return NumaTopology(std::move(nodes));
+}
+
+std::size_t NumaTopology::cpuCount() const {
+  std::size_t count = 0;
+  for (const auto &node : nodes_) {
+    count += node.cpus.size();
+  }
+  return count;
+}
+
+std::vector<int> NumaTopology::parseCpuList(const std::string &list) {
+  std::vector<int> cpus;
+  std::stringstream ss(list);
+  std::string range;
+  while (std::getline(ss, range, ',')) {
+    range.erase(std::remove_if(range.begin(), range.end(), ::isspace),
+                range.end());
+    if (range.empty())
+      continue;
+    auto dash = range.find('-');
+    try {
+      int first = std::stoi(range.substr(0, dash));
+      int last = dash == std::string::npos ? first
+                                           : std::stoi(range.substr(dash + 1));
+      for (int cpu = first; cpu <= last; ++cpu) {
+        cpus.push_back(cpu);
+      }
+    } catch (const std::logic_error &) {
+      throw std::invalid_argument("Malformed cpulist: " + list);
+    }
+  }
+  return cpus;
+}
+
+bool pinCurrentThread(const std::vector<int> &cpus) {
+#if defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (int cpu : cpus) {
+    if (cpu >= 0 && cpu < CPU_SETSIZE)
+      CPU_SET(cpu, &set);
+  }
+  if (CPU_COUNT(&set) == 0)
+    return false;
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+  (void)cpus;
+  return false;
+#endif
+}
+
+} // namespace quant
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace quant {
+
+struct NumaNode {
+  int id;
+  std::vector<int> cpus;
+};
+
+// NUMA layout of the machine, read from /sys/devices/system/node.
+//
+// Nodes without CPUs (memory-only nodes) are skipped. When sysfs is not
+// available - non-Linux systems, containers without /sys - detect() falls
+// back to a single node holding every hardware thread, so callers can use
+// the same sharded code path everywhere.
+class NumaTopology {
+public:
+  explicit NumaTopology(std::vector<NumaNode> nodes);
+
+  static NumaTopology detect();
+  static NumaTopology singleNode();
+
+  const std::vector<NumaNode> &nodes() const { return nodes_; }
+  std::size_t nodeCount() const { return nodes_.size(); }
+  std::size_t cpuCount() const;
+  bool isNuma() const { return nodes_.size() > 1; }
+
+  // Parse a sysfs cpulist such as "0-3,8,10-11"
+  static std::vector<int> parseCpuList(const std::string &list);
+
+private:
+  std::vector<NumaNode> nodes_;
+};
+
+// Restrict the calling thread to the given CPUs. Returns false (and leaves
+// the thread unpinned) if affinity is unsupported or the call fails.
+bool pinCurrentThread(const std::vector<int> &cpus);
+
+} // namespace quant
@@ -0,0 +1,74 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace quant {
+
+// Number of worker threads used when a caller passes threads = 0
+inline std::size_t defaultThreadCount() {
+  unsigned hw = std::thread::hardware_concurrency();
+  return hw == 0 ? 1 : static_cast<std::size_t>(hw);
+}
+
+// Run fn(begin, end) over contiguous, statically assigned slices of [0, n).
+// Slice boundaries depend only on n and the thread count, so the work split
+// is deterministic. The calling thread processes the first slice itself and
+// the first exception thrown by any slice is rethrown after all joins.
+template <typename Fn>
+void parallelForRange(std::size_t n, Fn &&fn, std::size_t threads = 0) {
+  if (n == 0)
+    return;
+  if (threads == 0)
+    threads = defaultThreadCount();
+  threads = std::min(threads, n);
+
+  if (threads == 1) {
+    fn(std::size_t{0}, n);
+    return;
+  }
+
+  std::vector<std::exception_ptr> errors(threads);
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+
+  auto slice = [&](std::size_t k) {
+    std::size_t begin = n * k / threads;
+    std::size_t end = n * (k + 1) / threads;
+    try {
+      fn(begin, end);
+    } catch (...) {
+      errors[k] = std::current_exception();
+    }
+  };
+
+  for (std::size_t k = 1; k < threads; ++k) {
+    workers.emplace_back(slice, k);
+  }
+  slice(0);
+
+  for (auto &w : workers) {
+    w.join();
+  }
+  for (const auto &e : errors) {
+    if (e)
+      std::rethrow_exception(e);
+  }
+}
+
+// Element-wise convenience wrapper: fn(i) for every i in [0, n)
+template <typename Fn>
+void parallelFor(std::size_t n, Fn &&fn, std::size_t threads = 0) {
+  parallelForRange(
+      n,
+      [&fn](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          fn(i);
+        }
+      },
+      threads);
+}
+
+} // namespace quant
@@ -0,0 +1,79 @@
+#include "QuoteFeed.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace quant {
+
+QuoteConflator::QuoteConflator(std::size_t pillars)
+    : count_(pillars), slots_(std::make_unique<Slot[]>(pillars)),
+      dirty_(pillars == 0 ? 1 : 2 * pillars) {
+  if (pillars == 0) {
+    throw std::invalid_argument("QuoteConflator needs at least one pillar");
+  }
+}
+
+void QuoteConflator::publish(std::uint32_t pillar, double value,
+                             std::int64_t stamp) {
+  if (pillar >= count_) {
+    throw std::out_of_range("Quote pillar index out of range");
+  }
+  Slot &slot = slots_[pillar];
+  slot.value.store(value);
+  slot.stamp.store(stamp);
+  if (!slot.pending.exchange(true)) {
+    // At most one pending entry per pillar plus the batch being drained, so
+    // a ring of twice the pillar count cannot be full
+    dirty_.tryPush(pillar);
+  }
+  published_.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::size_t QuoteConflator::drain(std::vector<QuoteUpdate> &out) {
+  return dirty_.drain(
+      [&](std::uint32_t pillar) {
+        Slot &slot = slots_[pillar];
+        // Clear first: a later publish re-queues the pillar
+        slot.pending.store(false);
+        out.push_back({pillar, slot.value.load(), slot.stamp.load()});
+      },
+      count_);
+}
+
+CurveFeed::CurveFeed(CurveRegistry &registry, std::string curve,
+                     std::vector<double> pillarTimes,
+                     std::vector<double> initialZeros)
+    : registry_(registry), curve_(std::move(curve)),
+      times_(std::move(pillarTimes)), zeros_(std::move(initialZeros)),
+      conflator_(times_.size()) {
+  if (times_.size() != zeros_.size()) {
+    throw std::invalid_argument("CurveFeed needs one zero rate per pillar");
+  }
+  quotes_.resize(times_.size());
+  if (registry_.contains(curve_)) {
+    registry_.update(curve_, build());
+  } else {
+    registry_.addCurve(curve_, build());
+  }
+}
+
+std::size_t CurveFeed::pump() {
+  batch_.clear();
+  if (conflator_.drain(batch_) == 0)
+    return 0;
+
+  for (const auto &u : batch_) {
+    zeros_[u.pillar] = u.value;
+  }
+  registry_.update(curve_, build());
+  ++rebuilds_;
+  return batch_.size();
+}
+
+DiscountCurve CurveFeed::build() {
+  for (std::size_t i = 0; i < times_.size(); ++i) {
+    quotes_[i] = {times_[i], std::exp(-zeros_[i] * times_[i])};
+  }
+  return DiscountCurve(quotes_);
+}
+
+} // namespace quant
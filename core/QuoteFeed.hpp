@@ -0,0 +1,93 @@
+#pragma once
+#include "CurveRegistry.hpp"
+#include "DiscountCurve.hpp"
+#include "SpscRing.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace quant {
+
+// Latest quote for one pillar as seen by the consumer
+struct QuoteUpdate {
+  std::uint32_t pillar;
+  double value;
+  std::int64_t stamp; // caller-defined, e.g. publish time in ns
+};
+
+// Conflating single-producer/single-consumer quote channel.
+//
+// Each pillar holds only its latest value. The producer queues a pillar's
+// index on the ring only when the pillar goes from clean to pending, so a
+// burst of N updates to one pillar costs one ring slot and the ring (sized
+// to twice the pillar count, to cover a batch being drained) never
+// overflows. The consumer clears the pending
+// flag before reading the value; a publish that races with the read sets
+// the flag again and re-queues the pillar, so no update is lost.
+class QuoteConflator {
+public:
+  explicit QuoteConflator(std::size_t pillars);
+
+  // Producer thread only
+  void publish(std::uint32_t pillar, double value, std::int64_t stamp = 0);
+
+  // Consumer thread only: append the latest value of every pending pillar to
+  // out (each pillar at most once) and return how many were appended
+  std::size_t drain(std::vector<QuoteUpdate> &out);
+
+  std::size_t pillars() const { return count_; }
+
+  // Updates published so far (producer count; approximate from other threads)
+  std::uint64_t published() const {
+    return published_.load(std::memory_order_relaxed);
+  }
+
+private:
+  struct alignas(64) Slot {
+    std::atomic<double> value{0.0};
+    std::atomic<std::int64_t> stamp{0};
+    std::atomic<bool> pending{false};
+  };
+
+  std::size_t count_;
+  std::unique_ptr<Slot[]> slots_;
+  SpscRing<std::uint32_t> dirty_;
+  std::atomic<std::uint64_t> published_{0};
+};
+
+// Curve-builder side of a quote feed: pillar zero rates (continuously
+// compounded) arrive through a QuoteConflator, and each pump() applies every
+// pending change in a single curve rebuild pushed into a CurveRegistry.
+class CurveFeed {
+public:
+  // initialZeros[i] is the starting zero rate for pillar time pillarTimes[i]
+  CurveFeed(CurveRegistry &registry, std::string curve,
+            std::vector<double> pillarTimes, std::vector<double> initialZeros);
+
+  QuoteConflator &quotes() { return conflator_; }
+
+  // Drain pending quotes; if any, rebuild the curve once and update the
+  // registry. Returns the number of pillars changed (0 if nothing pending).
+  std::size_t pump();
+
+  // Updates applied by the last non-empty pump, e.g. for latency stamps
+  const std::vector<QuoteUpdate> &lastBatch() const { return batch_; }
+  std::uint64_t rebuilds() const { return rebuilds_; }
+
+private:
+  CurveRegistry &registry_;
+  std::string curve_;
+  std::vector<double> times_;
+  std::vector<double> zeros_;
+  std::vector<ZeroQuote> quotes_;
+  std::vector<QuoteUpdate> batch_;
+  QuoteConflator conflator_;
+  std::uint64_t rebuilds_ = 0;
+
+  DiscountCurve build();
+};
+
+} // namespace quant
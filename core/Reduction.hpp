@@ -0,0 +1,90 @@
+#pragma once
+#include "Parallel.hpp"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace quant {
+
+// Reproducible reductions.
+//
+// Floating-point addition is not associative, so a parallel total normally
+// depends on how the work was split. The primitives here fix the summation
+// order up front: the input is cut into blocks whose boundaries depend only
+// on the input size, each block is reduced on its own (by whichever thread
+// picks it up), and the block results are combined with a fixed binary tree.
+// The result is therefore bitwise identical for any thread count or
+// schedule. The extra cost over a naive loop is one combine per block.
+
+// Elements per block for reproducibleSum
+constexpr std::size_t kReductionBlock = 4096;
+
+// Sum of v[0..n) using a fixed recursive halving; leaves of up to 32
+// elements are summed left to right. Also tighter error growth than a plain
+// loop (O(log n) rather than O(n) ulps).
+inline double pairwiseSum(const double *v, std::size_t n) {
+  if (n <= 32) {
+    double s = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+      s += v[i];
+    }
+    return s;
+  }
+  std::size_t half = n / 2;
+  return pairwiseSum(v, half) + pairwiseSum(v + half, n - half);
+}
+
+// Combine partials[0..n) in place along a fixed tree (stride doubling):
+// combine(into, from) folds `from` into `into`. Returns partials[0].
+template <typename T, typename Combine>
+T &treeReduce(std::vector<T> &partials, Combine &&combine) {
+  const std::size_t n = partials.size();
+  for (std::size_t stride = 1; stride < n; stride *= 2) {
+    for (std::size_t i = 0; i + stride < n; i += 2 * stride) {
+      combine(partials[i], partials[i + stride]);
+    }
+  }
+  return partials[0];
+}
+
+// Reduce [0, n) in fixed blocks of blockSize: blockFn(begin, end) produces a
+// block partial, and partials are merged with treeReduce. Blocks run in
+// parallel; the result does not depend on the thread count.
+template <typename T, typename BlockFn, typename Combine>
+T reproducibleReduce(std::size_t n, std::size_t blockSize, BlockFn &&blockFn,
+                     Combine &&combine, T identity, std::size_t threads = 0) {
+  if (n == 0)
+    return identity;
+  if (blockSize == 0)
+    blockSize = n;
+
+  const std::size_t blocks = (n + blockSize - 1) / blockSize;
+  std::vector<T> partials(blocks, identity);
+  parallelFor(
+      blocks,
+      [&](std::size_t b) {
+        std::size_t begin = b * blockSize;
+        std::size_t end = begin + blockSize < n ? begin + blockSize : n;
+        partials[b] = blockFn(begin, end);
+      },
+      threads);
+  return std::move(treeReduce(partials, combine));
+}
+
+// Thread-count independent sum of values
+inline double reproducibleSum(const double *values, std::size_t n,
+                              std::size_t threads = 0) {
+  return reproducibleReduce(
+      n, kReductionBlock,
+      [values](std::size_t begin, std::size_t end) {
+        return pairwiseSum(values + begin, end - begin);
+      },
+      [](double &into, double from) { into += from; }, 0.0, threads);
+}
+
+inline double reproducibleSum(const std::vector<double> &values,
+                              std::size_t threads = 0) {
+  return reproducibleSum(values.data(), values.size(), threads);
+}
+
+} // namespace quant
@@ -0,0 +1,125 @@
+#include "SpreadCurve.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace quant {
+
+// Flat spread constructor
+SpreadCurve::SpreadCurve(const DiscountCurve &base, double flatSpread)
+    : base_(&base), flat_(flatSpread) {
+  if (std::isnan(flatSpread) || std::isinf(flatSpread)) {
+    throw std::invalid_argument("Invalid spread: must be finite");
+  }
+}
+
+// Spread term-structure constructor
+SpreadCurve::SpreadCurve(const DiscountCurve &base,
+                         QUANT_SPAN<const SpreadQuote> spreads)
+    : base_(&base), flat_(0.0) {
+  if (spreads.empty()) {
+    throw std::invalid_argument(
+        "Cannot create spread curve with empty spread quotes");
+  }
+
+  std::vector<SpreadQuote> sorted(spreads.begin(), spreads.end());
+  for (const auto &q : sorted) {
+    if (q.time <= 0.0 || std::isnan(q.time) || std::isinf(q.time)) {
+      throw std::invalid_argument(
+          "Invalid spread time: must be positive and finite");
+    }
+    if (std::isnan(q.spread) || std::isinf(q.spread)) {
+      throw std::invalid_argument("Invalid spread: must be finite");
+    }
+  }
+  std::sort(sorted.begin(), sorted.end(),
+            [](const SpreadQuote &a, const SpreadQuote &b) {
+              return a.time < b.time;
+            });
+
+  if (sorted.size() == 1) {
+    // A single pillar is just a flat spread
+    flat_ = sorted.front().spread;
+    return;
+  }
+
+  times_.reserve(sorted.size());
+  spreads_.reserve(sorted.size());
+  for (const auto &q : sorted) {
+    times_.push_back(q.time);
+    spreads_.push_back(q.spread);
+  }
+}
+
+double SpreadCurve::df(double t) const { return std::exp(logDf(t)); }
+
+double SpreadCurve::logDf(double t) const {
+  double baseLog = base_->logDf(t); // validates t
+  if (t <= 0.0)
+    return 0.0;
+  std::size_t hint = 1;
+  return baseLog - spreadAt(t, hint) * t;
+}
+
+double SpreadCurve::spread(double t) const {
+  if (std::isnan(t) || std::isinf(t)) {
+    throw std::invalid_argument("Time must be finite");
+  }
+  std::size_t hint = 1;
+  return spreadAt(t, hint);
+}
+
+void SpreadCurve::df(QUANT_SPAN<const double> times,
+                     QUANT_SPAN<double> out) const {
+  base_->logDf(times, out);
+  dfFromBase(times, QUANT_SPAN<const double>(out.data(), out.size()), out);
+}
+
+void SpreadCurve::dfFromBase(QUANT_SPAN<const double> times,
+                             QUANT_SPAN<const double> baseLogDf,
+                             QUANT_SPAN<double> out) const {
+  if (times.size() != baseLogDf.size() || times.size() != out.size()) {
+    throw std::invalid_argument("Output size must match number of times");
+  }
+
+  if (times_.empty()) {
+    // Flat spread: branch-free loop the compiler can vectorize
+    for (std::size_t i = 0; i < times.size(); ++i) {
+      double t = times[i] > 0.0 ? times[i] : 0.0;
+      out[i] = std::exp(baseLogDf[i] - flat_ * t);
+    }
+    return;
+  }
+
+  std::size_t hint = 1;
+  for (std::size_t i = 0; i < times.size(); ++i) {
+    double t = times[i];
+    out[i] = t <= 0.0 ? 1.0 : std::exp(baseLogDf[i] - spreadAt(t, hint) * t);
+  }
+}
+
+double SpreadCurve::spreadAt(double t, std::size_t &hint) const {
+  if (times_.empty())
+    return flat_;
+  if (t <= times_.front())
+    return spreads_.front();
+  if (t >= times_.back())
+    return spreads_.back();
+
+  // Same segment-hint sweep as DiscountCurve: O(1) for sorted batches
+  if (hint == 0 || hint >= times_.size() || times_[hint - 1] >= t) {
+    hint = static_cast<std::size_t>(
+        std::lower_bound(times_.begin(), times_.end(), t) - times_.begin());
+  } else {
+    while (times_[hint] < t) {
+      ++hint;
+    }
+  }
+
+  double t0 = times_[hint - 1];
+  double t1 = times_[hint];
+  double w = (t - t0) / (t1 - t0);
+  return spreads_[hint - 1] + w * (spreads_[hint] - spreads_[hint - 1]);
+}
+
+} // namespace quant
@@ -0,0 +1,56 @@
+#pragma once
+#include "DiscountCurve.hpp"
+#include <vector>
+
+namespace quant {
+
+struct SpreadQuote {
+  double time;
+  double spread;
+}; // time in years, continuously compounded spread
+
+// Spread-over-base curve evaluated on demand:
+//   P_s(0,t) = P_base(0,t) * exp(-s(t) * t)
+//
+// Nothing is materialized: the curve holds a pointer to its base plus the
+// spread term structure, so thousands of issuer curves can share one base.
+// s(t) is flat, or linearly interpolated between spread pillars with flat
+// extrapolation. The base curve must outlive every SpreadCurve built on it.
+class SpreadCurve {
+public:
+  // Flat spread constructor
+  SpreadCurve(const DiscountCurve &base, double flatSpread);
+
+  // Spread term-structure constructor
+  SpreadCurve(const DiscountCurve &base, QUANT_SPAN<const SpreadQuote> spreads);
+
+  // The base is held by pointer, so a temporary one would dangle
+  SpreadCurve(const DiscountCurve &&base, double flatSpread) = delete;
+  SpreadCurve(const DiscountCurve &&base,
+              QUANT_SPAN<const SpreadQuote> spreads) = delete;
+
+  double df(double t) const;     // P_s(0,t)
+  double logDf(double t) const;  // ln P_s(0,t)
+  double spread(double t) const; // s(t)
+
+  // Batched evaluation; one exp per point on top of the base's ln(df)
+  void df(QUANT_SPAN<const double> times, QUANT_SPAN<double> out) const;
+
+  // Batched evaluation reusing base ln(df) values already computed for the
+  // same times, e.g. once per base for a whole set of issuer curves
+  void dfFromBase(QUANT_SPAN<const double> times,
+                  QUANT_SPAN<const double> baseLogDf,
+                  QUANT_SPAN<double> out) const;
+
+  const DiscountCurve &base() const { return *base_; }
+
+private:
+  const DiscountCurve *base_;
+  double flat_;
+  std::vector<double> times_;   // empty for a flat spread
+  std::vector<double> spreads_;
+
+  double spreadAt(double t, std::size_t &hint) const;
+};
+
+} // namespace quant
@@ -0,0 +1,99 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+namespace quant {
+
+// Bounded lock-free single-producer/single-consumer ring buffer.
+//
+// Capacity is rounded up to a power of two. Exactly one thread may push and
+// exactly one (other) thread may pop. Head and tail live on separate cache
+// lines, and each side keeps a cached copy of the other's index so the
+// shared counters are only re-read when the ring looks full (or empty).
+template <typename T> class SpscRing {
+  static_assert(std::is_nothrow_copy_assignable_v<T>,
+                "SpscRing elements must be nothrow copy-assignable");
+
+public:
+  explicit SpscRing(std::size_t capacity) {
+    if (capacity == 0) {
+      throw std::invalid_argument("SpscRing capacity must be positive");
+    }
+    std::size_t size = 1;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    mask_ = size - 1;
+    slots_ = std::make_unique<T[]>(size);
+  }
+
+  SpscRing(const SpscRing &) = delete;
+  SpscRing &operator=(const SpscRing &) = delete;
+
+  // Producer side; false when the ring is full
+  bool tryPush(const T &value) {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - headCache_ > mask_) {
+      headCache_ = head_.load(std::memory_order_acquire);
+      if (tail - headCache_ > mask_)
+        return false;
+    }
+    slots_[tail & mask_] = value;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer side; false when the ring is empty
+  bool tryPop(T &value) {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tailCache_) {
+      tailCache_ = tail_.load(std::memory_order_acquire);
+      if (head == tailCache_)
+        return false;
+    }
+    value = slots_[head & mask_];
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer side: pop up to maxItems elements, calling fn on each, and
+  // publish the new head once for the whole batch
+  template <typename Fn> std::size_t drain(Fn &&fn, std::size_t maxItems) {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    tailCache_ = tail_.load(std::memory_order_acquire);
+    std::size_t available = tailCache_ - head;
+    std::size_t count = available < maxItems ? available : maxItems;
+    for (std::size_t i = 0; i < count; ++i) {
+      fn(slots_[(head + i) & mask_]);
+    }
+    if (count > 0)
+      head_.store(head + count, std::memory_order_release);
+    return count;
+  }
+
+  std::size_t capacity() const { return mask_ + 1; }
+
+  // Approximate when called concurrently with push/pop
+  std::size_t size() const {
+    return tail_.load(std::memory_order_acquire) -
+           head_.load(std::memory_order_acquire);
+  }
+
+private:
+  static constexpr std::size_t kCacheLine = 64;
+
+  std::unique_ptr<T[]> slots_;
+  std::size_t mask_ = 0;
+
+  alignas(kCacheLine) std::atomic<std::size_t> head_{0}; // consumer owned
+  std::size_t tailCache_ = 0;
+
+  alignas(kCacheLine) std::atomic<std::size_t> tail_{0}; // producer owned
+  std::size_t headCache_ = 0;
+};
+
+} // namespace quant
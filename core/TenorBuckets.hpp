@@ -0,0 +1,54 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace quant {
+
+// Maturity bins defined by increasing edges (in years). Bucket i covers
+// (edges[i-1], edges[i]]; bucket 0 is everything up to edges[0] and the last
+// bucket everything beyond edges.back(), so there are edges.size() + 1.
+class TenorBuckets {
+public:
+  explicit TenorBuckets(std::vector<double> edges = {1, 2, 5, 10, 20, 30})
+      : edges_(std::move(edges)) {
+    for (std::size_t i = 0; i < edges_.size(); ++i) {
+      if (!(edges_[i] > (i == 0 ? 0.0 : edges_[i - 1]))) {
+        throw std::invalid_argument(
+            "Tenor bucket edges must be positive and strictly increasing");
+      }
+    }
+  }
+
+  std::size_t size() const { return edges_.size() + 1; }
+  const std::vector<double> &edges() const { return edges_; }
+
+  std::size_t index(double maturity) const {
+    return static_cast<std::size_t>(
+        std::lower_bound(edges_.begin(), edges_.end(), maturity) -
+        edges_.begin());
+  }
+
+  // e.g. "2-5Y", "30Y+"
+  std::string label(std::size_t bucket) const {
+    auto years = [](double t) {
+      std::string s = std::to_string(t);
+      s.erase(s.find_last_not_of('0') + 1);
+      if (s.back() == '.')
+        s.pop_back();
+      return s;
+    };
+    if (bucket == 0)
+      return "0-" + years(edges_.front()) + "Y";
+    if (bucket >= edges_.size())
+      return years(edges_.back()) + "Y+";
+    return years(edges_[bucket - 1]) + "-" + years(edges_[bucket]) + "Y";
+  }
+
+private:
+  std::vector<double> edges_;
+};
+
+} // namespace quant
@@ -0,0 +1,87 @@
+#include "Annuity.hpp"
+#include <cmath>
+
+namespace quant {
+
+namespace {
+
+// Smallest |1 - q| for which the closed forms are used. Σ qⁱ stays accurate
+// to ~1e-13 down to 1e-4; Σ i²·qⁱ needs 5e-3 (about a 1% semi-annual yield)
+// to stay within ~1e-10 relative, below which the loop is both cheap enough
+// and more accurate.
+constexpr double kMinPriceGap = 1e-4;
+constexpr double kMinMomentGap = 5e-3;
+
+} // namespace
+
+std::optional<double> Annuity::price(const BulletTerms &terms, double q) {
+  double oneMinusQ = 1.0 - q;
+  if (!(std::abs(oneMinusQ) >= kMinPriceGap) || !(q > 0.0)) {
+    return std::nullopt;
+  }
+
+  Sums s = sums(q, oneMinusQ, terms.periods);
+  return terms.coupon * s.s0 + terms.face * s.qn;
+}
+
+std::optional<Sensitivity::Moments>
+Annuity::moments(const BulletTerms &terms, double yield,
+                 Compounding compounding) {
+  // Same parameterization as Sensitivity: P(t) = exp(-c*t)
+  double c = yield;
+  double invBase = 1.0;
+  double invM = 0.0;
+  if (compounding != Compounding::Continuous) {
+    double m = static_cast<double>(compounding);
+    c = m * std::log1p(yield / m);
+    invBase = 1.0 / (1.0 + yield / m);
+    invM = 1.0 / m;
+  }
+
+  const double h = terms.period;
+  const double oneMinusQ = -std::expm1(-c * h);
+  if (!(std::abs(oneMinusQ) >= kMinMomentGap)) {
+    return std::nullopt;
+  }
+
+  const double n = static_cast<double>(terms.periods);
+  const double C = terms.coupon;
+  const double F = terms.face;
+  Sums s = sums(1.0 - oneMinusQ, oneMinusQ, terms.periods);
+
+  // ∑ PVᵢ tᵢ and ∑ PVᵢ (tᵢ² + tᵢ/m) with tᵢ = i*h
+  double sumI = C * s.s1 + F * n * s.qn;
+  double sumI2 = C * s.s2 + F * n * n * s.qn;
+  double sumT = h * sumI;
+  double sumT2 = h * h * sumI2 + h * invM * sumI;
+
+  Sensitivity::Moments mo;
+  mo.price = C * s.s0 + F * s.qn;
+  mo.delta = -sumT * invBase;
+  mo.gamma = sumT2 * invBase * invBase;
+  return mo;
+}
+
+Annuity::Sums Annuity::sums(double q, double oneMinusQ, int n) {
+  const double nd = static_cast<double>(n);
+  const double x = oneMinusQ;
+  // qⁿ and 1 - qⁿ from ln q, so 1 - qⁿ keeps full precision near q = 1
+  const double nLogQ = nd * std::log1p(-x);
+  const double qn = std::exp(nLogQ);
+  const double oneMinusQn = -std::expm1(nLogQ);
+
+  Sums s;
+  s.qn = qn;
+  // Σ qⁱ = q(1 - qⁿ)/(1 - q)
+  s.s0 = q * oneMinusQn / x;
+  // Σ i·qⁱ = q[(1 - qⁿ) - n·qⁿ(1 - q)]/(1 - q)²
+  s.s1 = q * (oneMinusQn - nd * qn * x) / (x * x);
+  // Σ i²·qⁱ = q[(1 + q) - (n+1)²qⁿ + (2n² + 2n - 1)qⁿ⁺¹ - n²qⁿ⁺²]/(1 - q)³
+  s.s2 = q *
+         ((1.0 + q) - (nd + 1.0) * (nd + 1.0) * qn +
+          (2.0 * nd * nd + 2.0 * nd - 1.0) * qn * q - nd * nd * qn * q * q) /
+         (x * x * x);
+  return s;
+}
+
+} // namespace quant
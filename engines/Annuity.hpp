@@ -0,0 +1,40 @@
+#pragma once
+#include "../core/CashFlow.hpp"
+#include "../core/DiscountCurve.hpp"
+#include "Sensitivity.hpp"
+#include <optional>
+
+namespace quant {
+
+// Closed-form pricing of regular bullet schedules (see bulletTerms).
+//
+// With per-period discount factor q, payments at i*h for i = 1..n:
+//   P = C * Σ qⁱ + F * qⁿ
+// and the duration/convexity sums Σ i·qⁱ, Σ i²·qⁱ are geometric-series
+// derivatives, so a 30y monthly bond costs the same as a 1y annual one.
+//
+// The closed forms cancel catastrophically as q -> 1 (near-zero yields),
+// so these return std::nullopt there and callers fall back to the loop.
+class Annuity {
+public:
+  // Price given the per-period discount factor q = P(0, period)
+  static std::optional<double> price(const BulletTerms &terms, double q);
+
+  // Price, ∂P/∂y and ∂²P/∂y² at a flat yield; matches Sensitivity::moments
+  static std::optional<Sensitivity::Moments>
+  moments(const BulletTerms &terms, double yield, Compounding compounding);
+
+private:
+  struct Sums {
+    double s0; // Σ qⁱ
+    double s1; // Σ i·qⁱ
+    double s2; // Σ i²·qⁱ
+    double qn; // qⁿ
+  };
+
+  // oneMinusQ is passed separately so callers can compute it without
+  // cancellation (e.g. via expm1)
+  static Sums sums(double q, double oneMinusQ, int n);
+};
+
+} // namespace quant
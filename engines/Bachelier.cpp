@@ -0,0 +1,107 @@
+#include "Bachelier.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace quant {
+
+namespace {
+
+const double kInvSqrt2Pi = 0.3989422804014327; // 1/√(2π)
+
+template <Precision P> double normalPDF(double x) {
+  return kInvSqrt2Pi * mathExp(-0.5 * x * x, P);
+}
+
+// Undiscounted call value
+template <Precision P>
+double callValue(double F, double K, double T, double sigma) {
+  if (T <= 0.0 || sigma <= 0.0) {
+    return std::max(F - K, 0.0);
+  }
+  const double stdDev = sigma * std::sqrt(T);
+  const double d = (F - K) / stdDev;
+  return (F - K) * mathNormCDF(d, P) + stdDev * normalPDF<P>(d);
+}
+
+void priceBatchExact(const Black76Batch &batch, QUANT_SPAN<double> out) {
+  const std::size_t n = batch.size();
+  for (std::size_t i = 0; i < n; ++i) {
+    const double F = batch.forward[i];
+    const double K = batch.strike[i];
+    const double D = batch.df[i];
+    const double call = D * callValue<Precision::Exact>(F, K, batch.expiry[i],
+                                                        batch.vol[i]);
+    // Put-call parity: P = C - D(F - K)
+    out[i] = batch.isCall[i] ? call : call - D * (F - K);
+  }
+}
+
+// Branch-free so the loop vectorizes, as in Black76::priceBatch: dead
+// lanes use a substitute variance and blend in the intrinsic value
+void priceBatchFast(const Black76Batch &batch, QUANT_SPAN<double> out) {
+  const std::size_t n = batch.size();
+  const double *forward = batch.forward.data();
+  const double *strike = batch.strike.data();
+  const double *expiry = batch.expiry.data();
+  const double *vol = batch.vol.data();
+  const double *df = batch.df.data();
+  const std::uint8_t *isCall = batch.isCall.data();
+  double *dst = out.data();
+  for (std::size_t i = 0; i < n; ++i) {
+    const double T = expiry[i];
+    const double sigma = vol[i];
+    const double D = df[i];
+    const double moneyness = forward[i] - strike[i];
+    const bool live = (T > 0.0) & (sigma > 0.0);
+
+    const double var = sigma * sigma * T;
+    const double varSafe =
+        var > 0.0 ? var : fastmath::detail::substitute(var, 1.0);
+    const double invStdDev = fastmath::rsqrt(varSafe);
+    const double d = moneyness * invStdDev;
+    const double call =
+        moneyness * fastmath::normCDF(d) +
+        varSafe * invStdDev * kInvSqrt2Pi * fastmath::exp(-0.5 * d * d);
+    const double value =
+        fastmath::detail::blend(live, call, std::max(moneyness, 0.0));
+    // Put-call parity: P = C - D(F - K)
+    dst[i] = D * fastmath::detail::blend(isCall[i] != 0, value,
+                                         value - moneyness);
+  }
+}
+
+} // namespace
+
+double Bachelier::price(double forwardPrice, double strike,
+                        double timeToExpiry, double volatility,
+                        double discountFactor, bool isCall) {
+  double call =
+      discountFactor * callValue<Precision::Exact>(forwardPrice, strike,
+                                                   timeToExpiry, volatility);
+  return isCall ? call : call - discountFactor * (forwardPrice - strike);
+}
+
+double Bachelier::vega(double forwardPrice, double strike, double timeToExpiry,
+                       double volatility, double discountFactor) {
+  if (timeToExpiry <= 0.0 || volatility <= 0.0) {
+    return 0.0;
+  }
+  const double sqrtT = std::sqrt(timeToExpiry);
+  const double d = (forwardPrice - strike) / (volatility * sqrtT);
+  return discountFactor * sqrtT * normalPDF<Precision::Exact>(d);
+}
+
+void Bachelier::priceBatch(const Black76Batch &batch, QUANT_SPAN<double> out,
+                           Precision precision) {
+  if (out.size() != batch.size()) {
+    throw std::invalid_argument("Output size must match batch size");
+  }
+  if (precision == Precision::Fast) {
+    priceBatchFast(batch, out);
+  } else {
+    priceBatchExact(batch, out);
+  }
+}
+
+} // namespace quant
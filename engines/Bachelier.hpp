@@ -0,0 +1,43 @@
+#pragma once
+#include "../core/FastMath.hpp"
+#include "Black76.hpp"
+
+namespace quant {
+
+// How an option volatility is quoted
+enum class VolatilityType {
+  Lognormal, // Black-76, σ relative to the forward
+  Normal     // Bachelier, σ in absolute rate units (works for F, K <= 0)
+};
+
+// Bachelier (normal) model for options on forwards
+class Bachelier {
+public:
+  // V = D[(F - K) N(d) + σ√T φ(d)] for calls, d = (F - K) / (σ√T);
+  // puts by put-call parity
+  static double price(double forwardPrice, double strike, double timeToExpiry,
+                      double volatility, double discountFactor,
+                      bool isCall = true);
+
+  // ∂V/∂σ = D √T φ(d)
+  static double vega(double forwardPrice, double strike, double timeToExpiry,
+                     double volatility, double discountFactor);
+
+  // Same SoA inputs and conventions as Black76::priceBatch, with batch.vol
+  // holding normal volatilities
+  static void priceBatch(const Black76Batch &batch, QUANT_SPAN<double> out,
+                         Precision precision = kDefaultPrecision);
+};
+
+// Dispatch a batch to the Black-76 or Bachelier kernel
+inline void priceOptionBatch(VolatilityType type, const Black76Batch &batch,
+                             QUANT_SPAN<double> out,
+                             Precision precision = kDefaultPrecision) {
+  if (type == VolatilityType::Normal) {
+    Bachelier::priceBatch(batch, out, precision);
+  } else {
+    Black76::priceBatch(batch, out, precision);
+  }
+}
+
+} // namespace quant
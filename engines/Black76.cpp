@@ -1,13 +1,7 @@
 #include "Black76.hpp"
+#include <algorithm>
 #include <cmath>
-
-// Use std::numbers::pi when available, fallback for compatibility
-#if __cpp_lib_math_constants >= 201907L
-#include <numbers>
-#define QUANT_PI std::numbers::pi
-#else
-#define QUANT_PI 3.14159265358979323846
-#endif
+#include <stdexcept>
 
 namespace quant {
 
@@ -74,6 +68,116 @@ double Black76::delta(double forwardPrice, double strike, double timeToExpiry,
   }
 }
 
+void Black76Batch::reserve(std::size_t n) {
+  forward.reserve(n);
+  strike.reserve(n);
+  expiry.reserve(n);
+  vol.reserve(n);
+  df.reserve(n);
+  isCall.reserve(n);
+}
+
+void Black76Batch::clear() {
+  forward.clear();
+  strike.clear();
+  expiry.clear();
+  vol.clear();
+  df.clear();
+  isCall.clear();
+}
+
+void Black76Batch::push_back(double F, double K, double T, double sigma,
+                             double D, bool call) {
+  forward.push_back(F);
+  strike.push_back(K);
+  expiry.push_back(T);
+  vol.push_back(sigma);
+  df.push_back(D);
+  isCall.push_back(call ? 1 : 0);
+}
+
+namespace {
+
+// Same d1/d2 and normCDF evaluation as price()
+void priceBatchExact(const Black76Batch &batch, QUANT_SPAN<double> out) {
+  const std::size_t n = batch.size();
+  for (std::size_t i = 0; i < n; ++i) {
+    const double F = batch.forward[i];
+    const double K = batch.strike[i];
+    const double T = batch.expiry[i];
+    const double sigma = batch.vol[i];
+    const double D = batch.df[i];
+
+    // w = +1 for calls, -1 for puts: V = w D [F N(w d1) - K N(w d2)]
+    const double w = batch.isCall[i] ? 1.0 : -1.0;
+    if (T <= 0.0 || sigma <= 0.0) {
+      out[i] = D * std::max(w * (F - K), 0.0);
+    } else {
+      const double sqrtT = std::sqrt(T);
+      const double d1v =
+          (std::log(F / K) + 0.5 * sigma * sigma * T) / (sigma * sqrtT);
+      const double d2v = d1v - sigma * sqrtT;
+      out[i] = w * D *
+               (F * mathNormCDF(w * d1v, Precision::Exact) -
+                K * mathNormCDF(w * d2v, Precision::Exact));
+    }
+  }
+}
+
+// Branch-free so the loop vectorizes: expired or zero-vol lanes run the
+// formula on substitute arguments and take the intrinsic value in the
+// final blend. σ√T and its inverse come from one rsqrt of σ²T.
+void priceBatchFast(const Black76Batch &batch, QUANT_SPAN<double> out) {
+  const std::size_t n = batch.size();
+  const double *forward = batch.forward.data();
+  const double *strike = batch.strike.data();
+  const double *expiry = batch.expiry.data();
+  const double *vol = batch.vol.data();
+  const double *df = batch.df.data();
+  const std::uint8_t *isCall = batch.isCall.data();
+  double *dst = out.data();
+  for (std::size_t i = 0; i < n; ++i) {
+    const double F = forward[i];
+    const double K = strike[i];
+    const double T = expiry[i];
+    const double sigma = vol[i];
+    const double D = df[i];
+
+    // w = +1 for calls, -1 for puts: V = w D [F N(w d1) - K N(w d2)]
+    const double w = isCall[i] ? 1.0 : -1.0;
+    const bool live = (T > 0.0) & (sigma > 0.0);
+
+    const double var = sigma * sigma * T;
+    const double varSafe =
+        var > 0.0 ? var : fastmath::detail::substitute(var, 1.0);
+    const double ratio = F / K;
+    const double ratioSafe =
+        ratio > 0.0 ? ratio : fastmath::detail::substitute(ratio, 1.0);
+    const double invStdDev = fastmath::rsqrt(varSafe);
+    const double d1v = (fastmath::log(ratioSafe) + 0.5 * varSafe) * invStdDev;
+    const double d2v = d1v - varSafe * invStdDev;
+    const double value = w * D *
+                         (F * fastmath::normCDF(w * d1v) -
+                          K * fastmath::normCDF(w * d2v));
+    const double intrinsic = D * std::max(w * (F - K), 0.0);
+    dst[i] = fastmath::detail::blend(live, value, intrinsic);
+  }
+}
+
+} // namespace
+
+void Black76::priceBatch(const Black76Batch &batch, QUANT_SPAN<double> out,
+                         Precision precision) {
+  if (out.size() != batch.size()) {
+    throw std::invalid_argument("Output size must match batch size");
+  }
+  if (precision == Precision::Fast) {
+    priceBatchFast(batch, out);
+  } else {
+    priceBatchExact(batch, out);
+  }
+}
+
 // Private helper functions
 
 double Black76::d1(double F, double K, double T, double sigma) {
@@ -93,7 +197,7 @@ double Black76::normCDF(double x) {
 
 double Black76::normPDF(double x) {
   // Standard normal PDF: φ(x) = (1/√(2π)) * e^(-x²/2)
-  return (1.0 / std::sqrt(2.0 * QUANT_PI)) * std::exp(-0.5 * x * x);
+  return (1.0 / std::sqrt(2.0 * kPi)) * std::exp(-0.5 * x * x);
 }
 
 } // namespace quant
\ No newline at end of file
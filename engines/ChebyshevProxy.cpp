@@ -0,0 +1,291 @@
+#include "ChebyshevProxy.hpp"
+#include "../core/FastMath.hpp"
+#include "../core/Parallel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace quant {
+
+namespace {
+
+const char *const kFormatTag = "quant::ChebyshevProxy";
+const int kFormatVersion = 1;
+
+// Points outside the box by less than this (relative to its width) are
+// treated as on the boundary
+const double kBoxTolerance = 1e-12;
+
+void validateAxis(const ChebyshevAxis &axis) {
+  if (!std::isfinite(axis.lo) || !std::isfinite(axis.hi) ||
+      !(axis.hi > axis.lo)) {
+    throw std::invalid_argument("Proxy axis must satisfy lo < hi");
+  }
+  if (axis.degree < 1 || axis.degree > ChebyshevProxy::kMaxDegree) {
+    throw std::invalid_argument("Proxy degree must be in [1, " +
+                                std::to_string(ChebyshevProxy::kMaxDegree) +
+                                "]");
+  }
+}
+
+// Map v in [lo, hi] to x in [-1, 1]
+double toUnit(const ChebyshevAxis &axis, double v) {
+  double x = (2.0 * v - (axis.lo + axis.hi)) / (axis.hi - axis.lo);
+  return std::max(-1.0, std::min(1.0, x));
+}
+
+bool inside(const ChebyshevAxis &axis, double v) {
+  double tol = kBoxTolerance * (axis.hi - axis.lo);
+  return v >= axis.lo - tol && v <= axis.hi + tol;
+}
+
+// Σ c_k T_k(x) by Clenshaw's recurrence
+double clenshaw(const double *c, std::size_t n, double x) {
+  double b1 = 0.0;
+  double b2 = 0.0;
+  const double twoX = 2.0 * x;
+  for (std::size_t k = n - 1; k > 0; --k) {
+    double b0 = c[k] + twoX * b1 - b2;
+    b2 = b1;
+    b1 = b0;
+  }
+  return c[0] + x * b1 - b2;
+}
+
+// Replace samples at first-kind nodes by Chebyshev coefficients along one
+// axis of the row-major tensor:
+//   c_k = (2/n) Σ_j f_j cos(πk(j + ½)/n),  c_0 halved
+void transformAxis(std::vector<double> &data,
+                   const std::array<std::size_t, 3> &sizes, std::size_t axis) {
+  const std::size_t n = sizes[axis];
+  std::size_t stride = 1;
+  for (std::size_t d = axis + 1; d < sizes.size(); ++d) {
+    stride *= sizes[d];
+  }
+  const std::size_t outer = data.size() / (n * stride);
+
+  std::vector<double> cosines(n * n);
+  for (std::size_t k = 0; k < n; ++k) {
+    for (std::size_t j = 0; j < n; ++j) {
+      cosines[k * n + j] = std::cos(kPi * static_cast<double>(k) *
+                                    (static_cast<double>(j) + 0.5) /
+                                    static_cast<double>(n));
+    }
+  }
+
+  std::vector<double> line(n);
+  for (std::size_t o = 0; o < outer; ++o) {
+    for (std::size_t s = 0; s < stride; ++s) {
+      double *base = data.data() + o * n * stride + s;
+      for (std::size_t j = 0; j < n; ++j) {
+        line[j] = base[j * stride];
+      }
+      for (std::size_t k = 0; k < n; ++k) {
+        double sum = 0.0;
+        for (std::size_t j = 0; j < n; ++j) {
+          sum += cosines[k * n + j] * line[j];
+        }
+        base[k * stride] = (k == 0 ? 1.0 : 2.0) * sum / static_cast<double>(n);
+      }
+    }
+  }
+}
+
+double readNumber(std::istream &in) {
+  std::string token;
+  if (!(in >> token)) {
+    throw std::runtime_error("ChebyshevProxy: unexpected end of input");
+  }
+  char *end = nullptr;
+  double value = std::strtod(token.c_str(), &end);
+  if (end == token.c_str() || *end != '\0') {
+    throw std::runtime_error("ChebyshevProxy: invalid number '" + token +
+                             "'");
+  }
+  return value;
+}
+
+} // namespace
+
+ChebyshevProxy::ChebyshevProxy(const Axes &axes,
+                               std::vector<double> coefficients)
+    : axes_(axes), coefficients_(std::move(coefficients)) {
+  for (std::size_t d = 0; d < kDimensions; ++d) {
+    sizes_[d] = axes_[d].degree + 1;
+  }
+}
+
+std::vector<double> ChebyshevProxy::nodes(const ChebyshevAxis &axis) {
+  validateAxis(axis);
+  const std::size_t n = axis.degree + 1;
+  const double mid = 0.5 * (axis.lo + axis.hi);
+  const double half = 0.5 * (axis.hi - axis.lo);
+  std::vector<double> points(n);
+  for (std::size_t j = 0; j < n; ++j) {
+    double x = std::cos(kPi * (static_cast<double>(j) + 0.5) /
+                        static_cast<double>(n));
+    points[j] = mid + half * x;
+  }
+  return points;
+}
+
+ChebyshevProxy ChebyshevProxy::build(const Pricer &pricer, const Axes &axes,
+                                     std::size_t threads) {
+  if (!pricer) {
+    throw std::invalid_argument("Proxy pricer must be callable");
+  }
+  std::array<std::vector<double>, kDimensions> grid;
+  std::array<std::size_t, kDimensions> sizes;
+  for (std::size_t d = 0; d < kDimensions; ++d) {
+    grid[d] = nodes(axes[d]);
+    sizes[d] = grid[d].size();
+  }
+
+  // Each node writes its own slot, so the samples do not depend on threads
+  std::vector<double> values(sizes[0] * sizes[1] * sizes[2]);
+  parallelFor(
+      values.size(),
+      [&](std::size_t idx) {
+        std::size_t k = idx % sizes[2];
+        std::size_t j = (idx / sizes[2]) % sizes[1];
+        std::size_t i = idx / (sizes[2] * sizes[1]);
+        values[idx] = pricer(grid[0][i], grid[1][j], grid[2][k]);
+      },
+      threads);
+
+  for (double v : values) {
+    if (!std::isfinite(v)) {
+      throw std::runtime_error("ChebyshevProxy: pricer returned a non-finite "
+                               "value on the sample grid");
+    }
+  }
+
+  for (std::size_t d = 0; d < kDimensions; ++d) {
+    transformAxis(values, sizes, d);
+  }
+  return ChebyshevProxy(axes, std::move(values));
+}
+
+bool ChebyshevProxy::contains(double forward, double sigma,
+                              double expiry) const {
+  return inside(axes_[0], forward) && inside(axes_[1], sigma) &&
+         inside(axes_[2], expiry);
+}
+
+double ChebyshevProxy::operator()(double forward, double sigma,
+                                  double expiry) const {
+  if (!contains(forward, sigma, expiry)) {
+    throw std::out_of_range("Point lies outside the proxy box");
+  }
+  const double x = toUnit(axes_[0], forward);
+  const double y = toUnit(axes_[1], sigma);
+  const double z = toUnit(axes_[2], expiry);
+
+  // The innermost (expiry) contraction is a dot product with T_k(z), which
+  // has no loop-carried dependency; vol and forward then collapse by
+  // Clenshaw over the much shorter reduced series
+  std::array<double, kMaxDegree + 1> basis;
+  basis[0] = 1.0;
+  basis[1] = z;
+  for (std::size_t k = 2; k < sizes_[2]; ++k) {
+    basis[k] = 2.0 * z * basis[k - 1] - basis[k - 2];
+  }
+
+  std::array<double, kMaxDegree + 1> alongF;
+  std::array<double, kMaxDegree + 1> alongSigma;
+  const double *c = coefficients_.data();
+  for (std::size_t i = 0; i < sizes_[0]; ++i) {
+    for (std::size_t j = 0; j < sizes_[1]; ++j) {
+      double sum = 0.0;
+      for (std::size_t k = 0; k < sizes_[2]; ++k) {
+        sum += c[k] * basis[k];
+      }
+      alongSigma[j] = sum;
+      c += sizes_[2];
+    }
+    alongF[i] = clenshaw(alongSigma.data(), sizes_[1], y);
+  }
+  return clenshaw(alongF.data(), sizes_[0], x);
+}
+
+double ChebyshevProxy::tailEstimate(std::size_t axis) const {
+  if (axis >= kDimensions) {
+    throw std::out_of_range("Proxy axis index out of range");
+  }
+  // Top two degrees along the axis (just the top one at degree 1)
+  const std::size_t first = sizes_[axis] > 2 ? sizes_[axis] - 2 : 1;
+  double tail = 0.0;
+  for (std::size_t idx = 0; idx < coefficients_.size(); ++idx) {
+    std::size_t index[kDimensions] = {idx / (sizes_[2] * sizes_[1]),
+                                      (idx / sizes_[2]) % sizes_[1],
+                                      idx % sizes_[2]};
+    if (index[axis] >= first) {
+      tail += std::abs(coefficients_[idx]);
+    }
+  }
+  return tail;
+}
+
+double ChebyshevProxy::errorEstimate() const {
+  double total = 0.0;
+  for (std::size_t d = 0; d < kDimensions; ++d) {
+    total += tailEstimate(d);
+  }
+  return total;
+}
+
+void ChebyshevProxy::save(std::ostream &out) const {
+  const auto flags = out.flags();
+  out << kFormatTag << ' ' << kFormatVersion << '\n' << std::hexfloat;
+  for (const ChebyshevAxis &axis : axes_) {
+    out << axis.lo << ' ' << axis.hi << ' ' << axis.degree << '\n';
+  }
+  for (double c : coefficients_) {
+    out << c << '\n';
+  }
+  out.flags(flags);
+  if (!out) {
+    throw std::runtime_error("ChebyshevProxy: failed to write proxy");
+  }
+}
+
+ChebyshevProxy ChebyshevProxy::load(std::istream &in) {
+  std::string tag;
+  int version = 0;
+  if (!(in >> tag >> version) || tag != kFormatTag) {
+    throw std::runtime_error("ChebyshevProxy: not a serialized proxy");
+  }
+  if (version != kFormatVersion) {
+    throw std::runtime_error("ChebyshevProxy: unsupported format version " +
+                             std::to_string(version));
+  }
+
+  Axes axes;
+  std::size_t count = 1;
+  for (ChebyshevAxis &axis : axes) {
+    axis.lo = readNumber(in);
+    axis.hi = readNumber(in);
+    if (!(in >> axis.degree)) {
+      throw std::runtime_error("ChebyshevProxy: invalid axis degree");
+    }
+    try {
+      validateAxis(axis);
+    } catch (const std::invalid_argument &e) {
+      throw std::runtime_error(std::string("ChebyshevProxy: ") + e.what());
+    }
+    count *= axis.degree + 1;
+  }
+
+  std::vector<double> coefficients(count);
+  for (double &c : coefficients) {
+    c = readNumber(in);
+  }
+  return ChebyshevProxy(axes, std::move(coefficients));
+}
+
+} // namespace quant
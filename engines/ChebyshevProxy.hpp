@@ -0,0 +1,73 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <vector>
+
+namespace quant {
+
+// One dimension of the proxy box: [lo, hi] sampled at degree + 1 nodes
+struct ChebyshevAxis {
+  double lo;
+  double hi;
+  std::size_t degree;
+};
+
+// Tensor Chebyshev interpolant of a pricer over a (forward, vol, expiry) box.
+//
+// build() samples the pricer on the tensor grid of Chebyshev points of the
+// first kind (endpoints excluded, so a box starting at T = 0 is safe) in
+// parallel, then turns the samples into Chebyshev coefficients with one
+// cosine transform per axis. Evaluation contracts the expiry axis against
+// T_k(z) and collapses vol and forward with Clenshaw recurrences: about
+// (d_F + 1)(d_σ + 1)(d_T + 1) multiply-adds and no transcendental calls.
+//
+// The pricer is called concurrently and must be thread-safe. Monte Carlo
+// pricers should use a fixed seed so neighbouring nodes share random
+// numbers; otherwise sampling noise shows up as a flat coefficient tail.
+class ChebyshevProxy {
+public:
+  static constexpr std::size_t kDimensions = 3; // forward, sigma, expiry
+  static constexpr std::size_t kMaxDegree = 64;
+
+  using Axes = std::array<ChebyshevAxis, kDimensions>;
+  using Pricer =
+      std::function<double(double forward, double sigma, double expiry)>;
+
+  static ChebyshevProxy build(const Pricer &pricer, const Axes &axes,
+                              std::size_t threads = 0);
+
+  // Sample points of one axis, mapped into [lo, hi]
+  static std::vector<double> nodes(const ChebyshevAxis &axis);
+
+  // Throws std::out_of_range outside the box: the proxy does not extrapolate
+  double operator()(double forward, double sigma, double expiry) const;
+  bool contains(double forward, double sigma, double expiry) const;
+
+  // Coefficient-tail error estimate. For smooth pricers the coefficients
+  // decay geometrically, so the magnitude of the two highest degrees along
+  // an axis is of the order of the truncation error in that direction.
+  // A tail that does not shrink when the degree is raised points at noise
+  // or a kink (e.g. an expiry-zero payoff) rather than too few nodes.
+  double tailEstimate(std::size_t axis) const;
+  double errorEstimate() const; // sum over axes
+
+  const Axes &axes() const { return axes_; }
+  std::size_t sampleCount() const { return coefficients_.size(); }
+
+  // Text format with hex-float coefficients, so a proxy reloads bit-exact
+  // in another process. load() throws std::runtime_error on malformed input.
+  void save(std::ostream &out) const;
+  static ChebyshevProxy load(std::istream &in);
+
+private:
+  ChebyshevProxy(const Axes &axes, std::vector<double> coefficients);
+
+  Axes axes_;
+  std::array<std::size_t, kDimensions> sizes_; // degree + 1 per axis
+  // c[i][j][k] at (i * sizes_[1] + j) * sizes_[2] + k, expiry fastest
+  std::vector<double> coefficients_;
+};
+
+} // namespace quant
@@ -0,0 +1,172 @@
+#include "CurveBootstrapper.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace quant {
+
+namespace {
+
+const double kTolerance = 1e-14;
+const int kMaxIterations = 50;
+
+// ln P(t) and its sensitivity to the (at most two) pillars it depends on,
+// following DiscountCurve's log-linear interpolation with flat extrapolation
+// before the first pillar. Only pillars [0, solved] are used.
+struct LogDfTerm {
+  double logDf;
+  std::size_t lo, hi; // pillar indices
+  double dLo, dHi;    // d ln P / d z_lo, d ln P / d z_hi
+};
+
+LogDfTerm logDfTerm(double t, const std::vector<double> &times,
+                    const std::vector<double> &zeros, std::size_t solved) {
+  if (t <= times[0]) {
+    return {-zeros[0] * times[0], 0, 0, -times[0], 0.0};
+  }
+
+  std::size_t i = 1;
+  while (i < solved && times[i] < t) {
+    ++i;
+  }
+  double t0 = times[i - 1];
+  double t1 = times[i];
+  double w = (t - t0) / (t1 - t0);
+  double lnP0 = -zeros[i - 1] * t0;
+  double lnP1 = -zeros[i] * t1;
+  return {lnP0 + w * (lnP1 - lnP0), i - 1, i, -(1.0 - w) * t0, -w * t1};
+}
+
+} // namespace
+
+CurveBootstrapper::Result
+CurveBootstrapper::bootstrap(QUANT_SPAN<const MarketQuote> quotes) {
+  const std::size_t n = quotes.size();
+  if (n == 0) {
+    throw std::invalid_argument("Cannot bootstrap a curve without quotes");
+  }
+
+  std::vector<double> times(n);
+  for (std::size_t k = 0; k < n; ++k) {
+    const MarketQuote &q = quotes[k];
+    if (!(q.maturity > 0.0) || std::isinf(q.maturity)) {
+      throw std::invalid_argument(
+          "Invalid quote maturity: must be positive and finite");
+    }
+    if (std::isnan(q.rate) || std::isinf(q.rate)) {
+      throw std::invalid_argument("Invalid quote rate: must be finite");
+    }
+    if (k > 0 && !(q.maturity > times[k - 1])) {
+      throw std::invalid_argument(
+          "Quote maturities must be strictly increasing");
+    }
+    times[k] = q.maturity;
+  }
+
+  Result result;
+  result.zeroRates.assign(n, 0.0);
+  result.jacobian = Eigen::MatrixXd::Zero(n, n);
+  std::vector<double> &zeros = result.zeroRates;
+
+  // ∂F_k/∂z_j for the current instrument
+  std::vector<double> dFdz(n, 0.0);
+
+  for (std::size_t k = 0; k < n; ++k) {
+    const MarketQuote &q = quotes[k];
+    const double T = q.maturity;
+    double dFdq = 0.0;
+    std::fill(dFdz.begin(), dFdz.begin() + k + 1, 0.0);
+
+    if (q.type == MarketQuote::Type::Deposit) {
+      // F = z_k - ln(1 + rT)/T: solved directly
+      double growth = 1.0 + q.rate * T;
+      if (!(growth > 0.0)) {
+        throw std::invalid_argument("Deposit rate implies non-positive DF");
+      }
+      zeros[k] = std::log(growth) / T;
+      dFdz[k] = 1.0;
+      dFdq = -1.0 / growth;
+    } else {
+      // F = S * Σ τ P(t_j) + P(T) - 1, fixed leg on a regular grid
+      if (q.fixedFrequency <= 0) {
+        throw std::invalid_argument("Swap fixed frequency must be positive");
+      }
+      const double tau = 1.0 / q.fixedFrequency;
+      const long payments = std::lround(T * q.fixedFrequency);
+      if (payments < 1 || std::abs(payments * tau - T) > 1e-9) {
+        throw std::invalid_argument(
+            "Swap maturity must be a whole number of fixed periods: " +
+            std::to_string(T));
+      }
+
+      // Newton on z_k; earlier pillars are fixed
+      zeros[k] = k > 0 ? zeros[k - 1] : q.rate;
+      double annuity = 0.0;
+      bool converged = false;
+      for (int iter = 0; iter < kMaxIterations; ++iter) {
+        std::fill(dFdz.begin(), dFdz.begin() + k + 1, 0.0);
+        annuity = 0.0;
+        for (long j = 1; j <= payments; ++j) {
+          double t = (j == payments) ? T : j * tau;
+          LogDfTerm term = logDfTerm(t, times, zeros, k);
+          double pv = tau * std::exp(term.logDf);
+          annuity += pv;
+          dFdz[term.lo] += q.rate * pv * term.dLo;
+          dFdz[term.hi] += q.rate * pv * term.dHi;
+        }
+        double dfT = std::exp(-zeros[k] * T);
+        dFdz[k] += -T * dfT;
+
+        double residual = q.rate * annuity + dfT - 1.0;
+        if (std::abs(residual) < kTolerance) {
+          converged = true;
+          break;
+        }
+        zeros[k] -= residual / dFdz[k];
+      }
+      if (!converged) {
+        throw std::runtime_error(
+            "CurveBootstrapper: swap pillar did not converge at " +
+            std::to_string(T));
+      }
+      dFdq = annuity;
+    }
+
+    // Implicit function theorem, row k:
+    //   dz_k/dq = -(∂F/∂q_k e_k + Σ_{j<k} ∂F/∂z_j dz_j/dq) / (∂F/∂z_k)
+    Eigen::RowVectorXd row = Eigen::RowVectorXd::Zero(n);
+    row(k) = dFdq;
+    for (std::size_t j = 0; j < k; ++j) {
+      if (dFdz[j] != 0.0) {
+        row += dFdz[j] * result.jacobian.row(j);
+      }
+    }
+    result.jacobian.row(k) = -row / dFdz[k];
+  }
+
+  result.pillars.reserve(n);
+  for (std::size_t k = 0; k < n; ++k) {
+    result.pillars.push_back({times[k], std::exp(-zeros[k] * times[k])});
+  }
+  return result;
+}
+
+Eigen::MatrixXd CurveBootstrapper::quoteRisk(const Eigen::MatrixXd &pillarRisk,
+                                             const Eigen::MatrixXd &jacobian) {
+  if (pillarRisk.cols() != jacobian.rows()) {
+    throw std::invalid_argument("Pillar risk columns must match pillars");
+  }
+  return pillarRisk * jacobian.triangularView<Eigen::Lower>();
+}
+
+Eigen::RowVectorXd
+CurveBootstrapper::quoteRisk(const Eigen::RowVectorXd &pillarRisk,
+                             const Eigen::MatrixXd &jacobian) {
+  if (pillarRisk.size() != jacobian.rows()) {
+    throw std::invalid_argument("Pillar risk size must match pillars");
+  }
+  return pillarRisk * jacobian.triangularView<Eigen::Lower>();
+}
+
+} // namespace quant
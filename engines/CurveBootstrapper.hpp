@@ -0,0 +1,51 @@
+#pragma once
+#include "../core/DiscountCurve.hpp"
+#include <Eigen/Dense>
+#include <vector>
+
+namespace quant {
+
+// Market instrument quoted for curve construction
+struct MarketQuote {
+  enum class Type { Deposit, Swap };
+
+  Type type;
+  double maturity;        // years
+  double rate;            // simple deposit rate or par swap rate
+  int fixedFrequency = 1; // swap fixed-leg payments per year
+};
+
+// Sequential bootstrap of a DiscountCurve from deposits and par swaps.
+//
+// One pillar is placed at each quote maturity and solved so the instrument
+// reprices exactly under the curve's own log-linear interpolation. Swaps
+// are single-curve (floating leg worth par) with fixed coupons every
+// 1/fixedFrequency years.
+//
+// The Jacobian d(zero rate_i)/d(quote_j) falls out of the same pass via the
+// implicit function theorem: each pillar's residual depends only on earlier
+// pillars, so the Jacobian is lower triangular and is filled row by row by
+// forward substitution.
+class CurveBootstrapper {
+public:
+  struct Result {
+    std::vector<ZeroQuote> pillars; // one per quote, at its maturity
+    std::vector<double> zeroRates;  // continuously compounded, per pillar
+    Eigen::MatrixXd jacobian;       // d(zeroRates_i)/d(quote_j)
+
+    DiscountCurve curve() const { return DiscountCurve(pillars); }
+  };
+
+  // Quotes must have strictly increasing maturities
+  static Result bootstrap(QUANT_SPAN<const MarketQuote> quotes);
+
+  // Map zero-rate pillar risk to market-quote risk: dV/dq = dV/dz * dz/dq.
+  // Rows of pillarRisk are positions (or portfolios), columns are pillars;
+  // the whole book is mapped in one triangular matrix product.
+  static Eigen::MatrixXd quoteRisk(const Eigen::MatrixXd &pillarRisk,
+                                   const Eigen::MatrixXd &jacobian);
+  static Eigen::RowVectorXd quoteRisk(const Eigen::RowVectorXd &pillarRisk,
+                                      const Eigen::MatrixXd &jacobian);
+};
+
+} // namespace quant
@@ -1,4 +1,6 @@
 #include "MonteCarlo.hpp"
+#include "../core/HugePages.hpp"
+#include "../core/Reduction.hpp"
 #include "../instruments/EuropeanBondOption.hpp"
 #include <Eigen/Dense>
 #include <algorithm>
@@ -6,6 +8,7 @@
 #include <iostream>
 #include <random>
 #include <utility>
+#include <vector>
 
 namespace quant {
 
@@ -36,8 +39,10 @@ MonteCarlo::MCResult MonteCarlo::mcPriceWithStats(double F0, double K,
   MCResult result;
   result.effectivePaths = config.useAntithetic ? N * 2 : N;
 
-  // Store payoffs for statistics
-  std::vector<double> payoffs;
+  // Store payoffs for statistics (2 doubles per path with antithetics, so
+  // large runs are backed by huge pages)
+  HugePageVector<double> payoffs{
+      HugePageAllocator<double>("MonteCarlo.payoffs")};
   payoffs.reserve(result.effectivePaths);
 
   // Precompute drift and volatility terms once
@@ -85,13 +90,21 @@ MonteCarlo::MCResult MonteCarlo::mcPriceWithStats(double F0, double K,
     }
   }
 
-  // Calculate statistics
-  double sum = 0.0;
-  double sumSquares = 0.0;
-  for (double p : payoffs) {
-    sum += p;
-    sumSquares += p * p;
-  }
+  // Calculate statistics with a fixed summation order, so the result does
+  // not change if path generation is later split across threads. The
+  // reductions themselves stay on the calling thread: one pass over the
+  // payoffs is too little work to pay for spawning workers.
+  double sum = reproducibleSum(payoffs.data(), payoffs.size(), 1);
+  double sumSquares = reproducibleReduce(
+      payoffs.size(), kReductionBlock,
+      [&payoffs](std::size_t begin, std::size_t end) {
+        double s = 0.0;
+        for (std::size_t i = begin; i < end; ++i) {
+          s += payoffs[i] * payoffs[i];
+        }
+        return s;
+      },
+      [](double &into, double from) { into += from; }, 0.0, 1);
 
   result.price = df * sum / payoffs.size();
 
@@ -118,12 +131,18 @@ double MonteCarlo::simulateVectorized(double F0, double K, double sigma,
   double drift = -0.5 * sigma * sigma * T;
 
   std::normal_distribution<double> normal(0.0, 1.0);
-  double payoffSum = 0.0;
   std::size_t totalPaths = 0;
 
+  // Each batch is summed pairwise and batch sums are combined along a fixed
+  // tree, so the total depends only on the batch layout
+  std::vector<double> batchPayoffs;
+  std::vector<double> batchSums;
+  batchSums.reserve((N + config.batchSize - 1) / config.batchSize);
+
   // Process in batches of 8k (or configured batch size)
   for (std::size_t batch = 0; batch < N; batch += config.batchSize) {
     std::size_t currentBatchSize = std::min(config.batchSize, N - batch);
+    batchPayoffs.clear();
 
     if (config.enableVectorization && currentBatchSize > 1) {
       // Generate random numbers for this batch
@@ -137,8 +156,8 @@ double MonteCarlo::simulateVectorized(double F0, double K, double sigma,
         auto [paths1, paths2] = generateAntitheticPaths(F0, sigma, T, randoms);
 
         for (std::size_t i = 0; i < currentBatchSize; ++i) {
-          payoffSum += payoff(paths1(i), K, tp);
-          payoffSum += payoff(paths2(i), K, tp);
+          batchPayoffs.push_back(payoff(paths1(i), K, tp));
+          batchPayoffs.push_back(payoff(paths2(i), K, tp));
         }
         totalPaths += 2 * currentBatchSize;
 
@@ -147,7 +166,7 @@ double MonteCarlo::simulateVectorized(double F0, double K, double sigma,
         Eigen::ArrayXd paths = generatePaths(F0, sigma, T, randoms);
 
         for (std::size_t i = 0; i < currentBatchSize; ++i) {
-          payoffSum += payoff(paths(i), K, tp);
+          batchPayoffs.push_back(payoff(paths(i), K, tp));
         }
         totalPaths += currentBatchSize;
       }
@@ -158,19 +177,26 @@ double MonteCarlo::simulateVectorized(double F0, double K, double sigma,
 
         // F_T = F_0 * exp((-0.5*σ²)*T + σ*√T*Z)
         double FT = F0 * std::exp(drift + sigma * sqrtT * Z);
-        payoffSum += payoff(FT, K, tp);
+        batchPayoffs.push_back(payoff(FT, K, tp));
         totalPaths++;
 
         if (config.useAntithetic) {
           // Antithetic path: use -Z
           double FT_anti = F0 * std::exp(drift + sigma * sqrtT * (-Z));
-          payoffSum += payoff(FT_anti, K, tp);
+          batchPayoffs.push_back(payoff(FT_anti, K, tp));
           totalPaths++;
         }
       }
     }
+    batchSums.push_back(pairwiseSum(batchPayoffs.data(), batchPayoffs.size()));
   }
 
+  double payoffSum =
+      batchSums.empty()
+          ? 0.0
+          : treeReduce(batchSums,
+                       [](double &into, double from) { into += from; });
+
   // Return discounted average payoff
   return df * (payoffSum / totalPaths);
 }
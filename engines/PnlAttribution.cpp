@@ -0,0 +1,189 @@
+#include "PnlAttribution.hpp"
+#include "../core/Parallel.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace quant {
+
+double Attribution::explained() const {
+  double sum = carry + rollDown + parallel + residual + spread;
+  for (double k : keyRates) {
+    sum += k;
+  }
+  return sum;
+}
+
+PnlAttribution::PnlAttribution(std::vector<double> keyTenors,
+                               std::size_t threads)
+    : keyTenors_(std::move(keyTenors)), threads_(threads) {
+  if (keyTenors_.empty()) {
+    throw std::invalid_argument("At least one key tenor is required");
+  }
+  for (std::size_t i = 0; i < keyTenors_.size(); ++i) {
+    if (!(keyTenors_[i] > (i == 0 ? 0.0 : keyTenors_[i - 1]))) {
+      throw std::invalid_argument(
+          "Key tenors must be positive and strictly increasing");
+    }
+  }
+}
+
+double PnlAttribution::keyWeight(std::size_t j, double t) const {
+  const auto &k = keyTenors_;
+  const std::size_t last = k.size() - 1;
+  if (t <= k[0])
+    return j == 0 ? 1.0 : 0.0;
+  if (t >= k[last])
+    return j == last ? 1.0 : 0.0;
+  if (j > 0 && t > k[j - 1] && t <= k[j])
+    return (t - k[j - 1]) / (k[j] - k[j - 1]);
+  if (j < last && t > k[j] && t < k[j + 1])
+    return (k[j + 1] - t) / (k[j + 1] - k[j]);
+  return 0.0;
+}
+
+std::vector<Attribution>
+PnlAttribution::attribute(QUANT_SPAN<const AttributionPosition> positions,
+                          const DiscountCurve &curve0,
+                          const DiscountCurve &curve1, double dt) const {
+  if (!(dt >= 0.0) || std::isinf(dt)) {
+    throw std::invalid_argument("Attribution period must be non-negative");
+  }
+
+  // Curve-level quantities shared by every position
+  const std::size_t nKeys = keyTenors_.size();
+  std::vector<double> keyMoves(nKeys);
+  double parallelMove = 0.0;
+  for (std::size_t j = 0; j < nKeys; ++j) {
+    keyMoves[j] =
+        curve1.zeroRate(keyTenors_[j]) - curve0.zeroRate(keyTenors_[j]);
+    parallelMove += keyMoves[j];
+  }
+  parallelMove /= static_cast<double>(nKeys);
+  for (double &move : keyMoves) {
+    move -= parallelMove;
+  }
+  const double logDf0AtDt = dt > 0.0 ? curve0.logDf(dt) : 0.0;
+
+  std::vector<Attribution> results(positions.size());
+
+  parallelForRange(
+      positions.size(),
+      [&](std::size_t begin, std::size_t end) {
+        // Per-thread scratch, reused across positions
+        std::vector<double> times, rolled, lnP0, lnP0Rolled, lnP1Rolled;
+        std::vector<double> amounts, shift;
+
+        for (std::size_t p = begin; p < end; ++p) {
+          const AttributionPosition &pos = positions[p];
+          const auto &cfs = pos.bond.cashFlows();
+          Attribution &out = results[p];
+          out.keyRates.assign(nKeys, 0.0);
+
+          // Cash paid within (0, dt] and the flows still outstanding at dt
+          double received = 0.0;
+          double v0 = 0.0;
+          times.clear();
+          amounts.clear();
+          for (const auto &cf : cfs) {
+            if (cf.time <= 0.0)
+              continue;
+            if (cf.time <= dt) {
+              received += cf.amount;
+              v0 += cf.amount * std::exp(curve0.logDf(cf.time) -
+                                         pos.spread0 * cf.time);
+            } else {
+              times.push_back(cf.time);
+              amounts.push_back(cf.amount);
+            }
+          }
+
+          const std::size_t n = times.size();
+          rolled.resize(n);
+          for (std::size_t i = 0; i < n; ++i) {
+            rolled[i] = times[i] - dt;
+          }
+          lnP0.resize(n);
+          lnP0Rolled.resize(n);
+          lnP1Rolled.resize(n);
+          curve0.logDf(times, lnP0);
+          curve0.logDf(rolled, lnP0Rolled);
+          curve1.logDf(rolled, lnP1Rolled);
+
+          // Value of the outstanding flows given ln DF(i) for each of them
+          auto value = [&](auto &&logDf) {
+            double v = 0.0;
+            for (std::size_t i = 0; i < n; ++i) {
+              v += amounts[i] * std::exp(logDf(i));
+            }
+            return v;
+          };
+
+          const double s0 = pos.spread0;
+          v0 += value([&](std::size_t i) { return lnP0[i] - s0 * times[i]; });
+
+          // Forwards realised: P0(t) / P0(dt), spread likewise
+          double vCarry = received + value([&](std::size_t i) {
+                            return lnP0[i] - logDf0AtDt - s0 * rolled[i];
+                          });
+          double vRoll = received + value([&](std::size_t i) {
+                           return lnP0Rolled[i] - s0 * rolled[i];
+                         });
+          double vParallel = received + value([&](std::size_t i) {
+                               return lnP0Rolled[i] -
+                                      (parallelMove + s0) * rolled[i];
+                             });
+
+          // Key-rate moves applied cumulatively on top of the parallel move
+          shift.assign(n, parallelMove);
+          double previous = vParallel;
+          for (std::size_t j = 0; j < nKeys; ++j) {
+            for (std::size_t i = 0; i < n; ++i) {
+              shift[i] += keyWeight(j, rolled[i]) * keyMoves[j];
+            }
+            double v = received + value([&](std::size_t i) {
+                         return lnP0Rolled[i] - (shift[i] + s0) * rolled[i];
+                       });
+            out.keyRates[j] = pos.quantity * (v - previous);
+            previous = v;
+          }
+
+          double vCurve = received + value([&](std::size_t i) {
+                            return lnP1Rolled[i] - s0 * rolled[i];
+                          });
+          double v1 = received + value([&](std::size_t i) {
+                        return lnP1Rolled[i] - pos.spread1 * rolled[i];
+                      });
+
+          const double q = pos.quantity;
+          out.carry = q * (vCarry - v0);
+          out.rollDown = q * (vRoll - vCarry);
+          out.parallel = q * (vParallel - vRoll);
+          out.residual = q * (vCurve - previous);
+          out.spread = q * (v1 - vCurve);
+          out.total = q * (v1 - v0);
+        }
+      },
+      threads_);
+
+  return results;
+}
+
+Attribution
+PnlAttribution::sum(const std::vector<Attribution> &attributions) const {
+  Attribution total;
+  total.keyRates.assign(keyTenors_.size(), 0.0);
+  for (const auto &a : attributions) {
+    total.carry += a.carry;
+    total.rollDown += a.rollDown;
+    total.parallel += a.parallel;
+    total.residual += a.residual;
+    total.spread += a.spread;
+    total.total += a.total;
+    for (std::size_t j = 0; j < total.keyRates.size(); ++j) {
+      total.keyRates[j] += a.keyRates[j];
+    }
+  }
+  return total;
+}
+
+} // namespace quant
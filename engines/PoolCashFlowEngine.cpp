@@ -0,0 +1,101 @@
+#include "PoolCashFlowEngine.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace quant {
+
+PoolCashFlowEngine::PoolCashFlowEngine(std::vector<PrepaymentModel> scenarios)
+    : scenarios_(std::move(scenarios)) {
+  if (scenarios_.empty()) {
+    throw std::invalid_argument("At least one prepayment scenario required");
+  }
+}
+
+std::size_t PoolCashFlowEngine::addPool(const MortgagePool &pool,
+                                        double quantity) {
+  validatePool(pool);
+  pools_.push_back(pool);
+  quantities_.push_back(quantity);
+  maxAge_ = std::max(maxAge_, pool.ageMonths + pool.termMonths);
+  return pools_.size() - 1;
+}
+
+CashFlowBlock PoolCashFlowEngine::project() const {
+  const std::size_t S = scenarios_.size();
+
+  // SMM by loan age, age-major so one month reads S contiguous values
+  std::vector<double> smm(static_cast<std::size_t>(maxAge_ + 1) * S);
+  for (int age = 0; age <= maxAge_; ++age) {
+    for (std::size_t s = 0; s < S; ++s) {
+      smm[age * S + s] = scenarios_[s].smm(age);
+    }
+  }
+
+  std::size_t totalFlows = 0;
+  for (const MortgagePool &pool : pools_) {
+    totalFlows += static_cast<std::size_t>(pool.termMonths) * S;
+  }
+  CashFlowBlock block;
+  block.reserve(pools_.size() * S, totalFlows);
+
+  std::vector<double> sched, times, amounts, q(S), lane;
+  for (std::size_t p = 0; p < pools_.size(); ++p) {
+    const MortgagePool &pool = pools_[p];
+    const std::size_t n = static_cast<std::size_t>(pool.termMonths);
+    sched.resize(n + 1);
+    scheduledBalances(pool, sched);
+    times.resize(n);
+    for (std::size_t m = 0; m < n; ++m) {
+      times[m] = static_cast<double>(m + 1) / 12.0;
+    }
+
+    // Month-major amounts for every scenario of this pool
+    amounts.resize(n * S);
+    std::fill(q.begin(), q.end(), pool.balance);
+    const double netMonthly = pool.netCoupon / 12.0;
+    for (std::size_t m = 0; m < n; ++m) {
+      const double b0 = sched[m];
+      const double b1 = sched[m + 1];
+      const double scheduled = b0 * netMonthly + (b0 - b1);
+      const double *rate = &smm[(pool.ageMonths + m + 1) * S];
+      double *out = &amounts[m * S];
+      for (std::size_t s = 0; s < S; ++s) {
+        out[s] = q[s] * (scheduled + rate[s] * b1);
+        q[s] *= 1.0 - rate[s];
+      }
+    }
+
+    lane.resize(n);
+    for (std::size_t s = 0; s < S; ++s) {
+      for (std::size_t m = 0; m < n; ++m) {
+        lane[m] = amounts[m * S + s];
+      }
+      block.add(times, lane, quantities_[p]);
+    }
+  }
+  return block;
+}
+
+std::vector<CashFlow>
+PoolCashFlowEngine::project(const MortgagePool &pool,
+                            const PrepaymentModel &model) {
+  const int n = pool.termMonths;
+  std::vector<double> sched(static_cast<std::size_t>(std::max(n, 0)) + 1);
+  scheduledBalances(pool, sched);
+
+  std::vector<CashFlow> flows;
+  flows.reserve(static_cast<std::size_t>(n));
+  double balance = pool.balance;
+  for (int m = 1; m <= n; ++m) {
+    const double interest = balance * pool.netCoupon / 12.0;
+    const double scheduled = balance * (1.0 - sched[m] / sched[m - 1]);
+    const double prepaid =
+        model.smm(pool.ageMonths + m) * (balance - scheduled);
+    balance -= scheduled + prepaid;
+    flows.push_back({m / 12.0, interest + scheduled + prepaid});
+  }
+  return flows;
+}
+
+} // namespace quant
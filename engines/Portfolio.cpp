@@ -0,0 +1,40 @@
+#include "Portfolio.hpp"
+
+namespace quant {
+
+void InstrumentBlock<BondPosition>::add(const BondPosition &p,
+                                        std::size_t index) {
+  flows_.add(p.bond.cashFlows(), p.quantity);
+  index_.push_back(index);
+}
+
+void InstrumentBlock<BondPosition>::price(const DiscountCurve &curve,
+                                          QUANT_SPAN<double> out) {
+  const std::size_t n = index_.size();
+  values_.resize(n);
+  flows_.price(curve, 0, n, values_, scratch_);
+  for (std::size_t i = 0; i < n; ++i) {
+    out[index_[i]] = values_[i];
+  }
+}
+
+void InstrumentBlock<BondOptionPosition>::add(const BondOptionPosition &p,
+                                              std::size_t index) {
+  book_.add(p.option, p.sigma);
+  quantities_.push_back(p.quantity);
+  index_.push_back(index);
+}
+
+void InstrumentBlock<BondOptionPosition>::price(const DiscountCurve &curve,
+                                                QUANT_SPAN<double> out) {
+  // Same inputs as EuropeanBondOption::priceBlack: F = 1/P(T_bond),
+  // D = P(T_expiry)
+  values_.resize(index_.size());
+  book_.requote(curve, values_);
+
+  for (std::size_t i = 0; i < index_.size(); ++i) {
+    out[index_[i]] = quantities_[i] * values_[i];
+  }
+}
+
+} // namespace quant
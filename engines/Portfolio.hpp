@@ -0,0 +1,109 @@
+#pragma once
+#include "../core/CashFlowBlock.hpp"
+#include "../core/DiscountCurve.hpp"
+#include "../instruments/Bond.hpp"
+#include "../instruments/EuropeanBondOption.hpp"
+#include "PreparedOption.hpp"
+#include <cstddef>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+namespace quant {
+
+struct BondPosition {
+  Bond bond;
+  double quantity = 1.0;
+};
+
+struct BondOptionPosition {
+  EuropeanBondOption option;
+  double sigma; // Black-76 volatility
+  double quantity = 1.0;
+};
+
+// Homogeneous SoA storage and batch kernel for one instrument type. Each
+// specialisation keeps, per instrument, its position in the portfolio so
+// results can be scattered back into insertion order.
+template <typename T> class InstrumentBlock;
+
+template <> class InstrumentBlock<BondPosition> {
+public:
+  void add(const BondPosition &p, std::size_t index);
+  void price(const DiscountCurve &curve, QUANT_SPAN<double> out);
+  std::size_t size() const { return index_.size(); }
+
+private:
+  CashFlowBlock flows_; // amounts pre-scaled by quantity
+  std::vector<std::size_t> index_;
+  std::vector<double> values_;
+  std::vector<double> scratch_;
+};
+
+template <> class InstrumentBlock<BondOptionPosition> {
+public:
+  void add(const BondOptionPosition &p, std::size_t index);
+  void price(const DiscountCurve &curve, QUANT_SPAN<double> out);
+  std::size_t size() const { return index_.size(); }
+
+private:
+  PreparedOptionBook book_; // strike/vol invariants cached at insertion
+  std::vector<double> quantities_;
+  std::vector<std::size_t> index_;
+  std::vector<double> values_;
+};
+
+// Portfolio of mixed instruments, stored by type.
+//
+// Instruments are added as a std::variant over the type list Ts... and
+// routed (once, at insertion) to the InstrumentBlock for their type. Pricing
+// runs every block's batch kernel over contiguous arrays and scatters the
+// results into insertion order, so there is no per-instrument dispatch. A
+// new instrument type needs an InstrumentBlock specialisation and an entry
+// in the type list.
+template <typename... Ts> class BasicPortfolio {
+public:
+  using Instrument = std::variant<Ts...>;
+
+  // Returns the instrument's index in pricing output
+  std::size_t add(const Instrument &instrument) {
+    std::size_t index = size_++;
+    std::visit(
+        [&](const auto &inst) {
+          using T = std::decay_t<decltype(inst)>;
+          std::get<InstrumentBlock<T>>(blocks_).add(inst, index);
+        },
+        instrument);
+    return index;
+  }
+
+  std::size_t size() const { return size_; }
+
+  template <typename T> std::size_t count() const {
+    return std::get<InstrumentBlock<T>>(blocks_).size();
+  }
+
+  // Value (quantity * price) of every instrument in insertion order; out
+  // must have size() elements
+  void price(const DiscountCurve &curve, QUANT_SPAN<double> out) {
+    if (out.size() != size_) {
+      throw std::invalid_argument("Output size must match portfolio size");
+    }
+    std::apply([&](auto &...block) { (block.price(curve, out), ...); },
+               blocks_);
+  }
+
+  std::vector<double> price(const DiscountCurve &curve) {
+    std::vector<double> out(size_);
+    price(curve, out);
+    return out;
+  }
+
+private:
+  std::tuple<InstrumentBlock<Ts>...> blocks_;
+  std::size_t size_ = 0;
+};
+
+using Portfolio = BasicPortfolio<BondPosition, BondOptionPosition>;
+
+} // namespace quant
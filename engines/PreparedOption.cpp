@@ -0,0 +1,159 @@
+#include "PreparedOption.hpp"
+#include <stdexcept>
+
+namespace quant {
+
+PreparedOption::PreparedOption(const EuropeanBondOption &option, double sigma)
+    : PreparedOption(option.strike(), option.expiry(), sigma,
+                     option.type() == EuropeanBondOption::Type::Call,
+                     option.underlyingMaturity()) {}
+
+PreparedOption::PreparedOption(double strike, double expiry, double sigma,
+                               bool isCall, double underlyingMaturity)
+    : K_(strike), T_(expiry), sigma_(sigma),
+      maturity_(underlyingMaturity),
+      logK_(0.0), stdDev_(0.0), invStdDev_(0.0), halfVarT_(0.0),
+      isCall_(isCall), live_(expiry > 0.0 && sigma > 0.0) {
+  if (!(strike > 0.0)) {
+    throw std::invalid_argument("Strike must be positive");
+  }
+  if (std::isnan(expiry) || std::isnan(sigma)) {
+    throw std::invalid_argument("Expiry and volatility must not be NaN");
+  }
+  if (!(underlyingMaturity >= expiry)) {
+    throw std::invalid_argument(
+        "Underlying maturity must not be before option expiry");
+  }
+  logK_ = std::log(K_);
+  if (live_) {
+    stdDev_ = sigma_ * std::sqrt(T_);
+    invStdDev_ = 1.0 / stdDev_;
+    halfVarT_ = 0.5 * sigma_ * sigma_ * T_;
+  }
+}
+
+double PreparedOption::price(const DiscountCurve &curve) const {
+  return requote(curve.fwdBondPrice(maturity_), curve.df(T_));
+}
+
+void PreparedOptionBook::add(const PreparedOption &option) {
+  strike_.push_back(option.K_);
+  logK_.push_back(option.logK_);
+  stdDev_.push_back(option.stdDev_);
+  invStdDev_.push_back(option.invStdDev_);
+  halfVarT_.push_back(option.halfVarT_);
+  isCall_.push_back(option.isCall_ ? 1 : 0);
+  live_.push_back(option.live_ ? 1 : 0);
+  expiry_.push_back(option.T_);
+  maturity_.push_back(option.maturity_);
+}
+
+void PreparedOptionBook::reserve(std::size_t n) {
+  strike_.reserve(n);
+  logK_.reserve(n);
+  stdDev_.reserve(n);
+  invStdDev_.reserve(n);
+  halfVarT_.reserve(n);
+  isCall_.reserve(n);
+  live_.reserve(n);
+  expiry_.reserve(n);
+  maturity_.reserve(n);
+}
+
+namespace {
+
+struct BookView {
+  const double *strike;
+  const double *logK;
+  const double *stdDev;
+  const double *invStdDev;
+  const double *halfVarT;
+  const std::uint8_t *isCall;
+  const std::uint8_t *live;
+};
+
+void requoteExact(const BookView &book, QUANT_SPAN<const double> forwards,
+                  QUANT_SPAN<const double> dfs, QUANT_SPAN<double> out) {
+  const std::size_t n = out.size();
+  for (std::size_t i = 0; i < n; ++i) {
+    const double F = forwards[i];
+    const double K = book.strike[i];
+    const double D = dfs[i];
+
+    // w = +1 for calls, -1 for puts: V = w D [F N(w d1) - K N(w d2)]
+    const double w = book.isCall[i] ? 1.0 : -1.0;
+    if (!book.live[i]) {
+      out[i] = D * std::max(w * (F - K), 0.0);
+    } else {
+      const double d1 =
+          (std::log(F) - book.logK[i] + book.halfVarT[i]) * book.invStdDev[i];
+      const double d2 = d1 - book.stdDev[i];
+      out[i] = w * D *
+               (F * mathNormCDF(w * d1, Precision::Exact) -
+                K * mathNormCDF(w * d2, Precision::Exact));
+    }
+  }
+}
+
+// Branch-free so the loop vectorizes, as in Black76::priceBatch: dead
+// lanes (zero invariants) run on a substitute forward and blend in the
+// intrinsic value
+void requoteFast(const BookView &book, QUANT_SPAN<const double> forwards,
+                 QUANT_SPAN<const double> dfs, QUANT_SPAN<double> out) {
+  const std::size_t n = out.size();
+  const double *fwd = forwards.data();
+  const double *df = dfs.data();
+  double *dst = out.data();
+  for (std::size_t i = 0; i < n; ++i) {
+    const double F = fwd[i];
+    const double K = book.strike[i];
+    const double D = df[i];
+
+    const double w = book.isCall[i] ? 1.0 : -1.0;
+    const double safeF = F > 0.0 ? F : fastmath::detail::substitute(F, 1.0);
+    const double d1 =
+        (fastmath::log(safeF) - book.logK[i] + book.halfVarT[i]) *
+        book.invStdDev[i];
+    const double d2 = d1 - book.stdDev[i];
+    const double value = w * D *
+                         (F * fastmath::normCDF(w * d1) -
+                          K * fastmath::normCDF(w * d2));
+    const double intrinsic = D * std::max(w * (F - K), 0.0);
+    dst[i] = fastmath::detail::blend(book.live[i] != 0, value, intrinsic);
+  }
+}
+
+} // namespace
+
+void PreparedOptionBook::requote(QUANT_SPAN<const double> forwards,
+                                 QUANT_SPAN<const double> dfs,
+                                 QUANT_SPAN<double> out,
+                                 Precision precision) const {
+  if (forwards.size() != size() || dfs.size() != size() ||
+      out.size() != size()) {
+    throw std::invalid_argument("Requote inputs must match book size");
+  }
+  const BookView view{strike_.data(),   logK_.data(),     stdDev_.data(),
+                      invStdDev_.data(), halfVarT_.data(), isCall_.data(),
+                      live_.data()};
+  if (precision == Precision::Fast) {
+    requoteFast(view, forwards, dfs, out);
+  } else {
+    requoteExact(view, forwards, dfs, out);
+  }
+}
+
+void PreparedOptionBook::requote(const DiscountCurve &curve,
+                                 QUANT_SPAN<double> out, Precision precision) {
+  const std::size_t n = size();
+  forwards_.resize(n);
+  dfs_.resize(n);
+  curve.df(maturity_, forwards_, precision);
+  curve.df(expiry_, dfs_, precision);
+  for (std::size_t i = 0; i < n; ++i) {
+    forwards_[i] = forwards_[i] > 0.0 ? 1.0 / forwards_[i] : 0.0;
+  }
+  requote(forwards_, dfs_, out, precision);
+}
+
+} // namespace quant
@@ -0,0 +1,106 @@
+#pragma once
+#include "../core/DiscountCurve.hpp"
+#include "../core/FastMath.hpp"
+#include "../instruments/EuropeanBondOption.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace quant {
+
+// Black-76 terms of one option that do not move with the market.
+//
+// Strike, expiry and volatility fix √T, σ√T, ln K and ½σ²T, so requoting
+// after a forward or discount factor tick is one log, two N(.) calls and a
+// few multiplies: d1 = (ln F - ln K + ½σ²T) / (σ√T). Results match
+// Black76::price to rounding.
+class PreparedOption {
+public:
+  PreparedOption(const EuropeanBondOption &option, double sigma);
+  // underlyingMaturity (used by price(curve)) must not precede expiry
+  PreparedOption(double strike, double expiry, double sigma, bool isCall,
+                 double underlyingMaturity);
+
+  double requote(double forward, double df) const {
+    if (!live_) {
+      return isCall_ ? df * std::max(forward - K_, 0.0)
+                     : df * std::max(K_ - forward, 0.0);
+    }
+    const double d1 = (std::log(forward) - logK_ + halfVarT_) * invStdDev_;
+    const double d2 = d1 - stdDev_;
+    if (isCall_) {
+      return df * (forward * cdf(d1) - K_ * cdf(d2));
+    }
+    return df * (K_ * cdf(-d2) - forward * cdf(-d1));
+  }
+
+  // Same inputs as EuropeanBondOption::priceBlack: F = 1/P(T_bond),
+  // D = P(T_expiry)
+  double price(const DiscountCurve &curve) const;
+
+  double strike() const { return K_; }
+  double expiry() const { return T_; }
+  double sigma() const { return sigma_; }
+  double underlyingMaturity() const { return maturity_; }
+  bool isCall() const { return isCall_; }
+
+private:
+  friend class PreparedOptionBook;
+
+  static double cdf(double x) { return mathNormCDF(x, Precision::Exact); }
+
+  double K_;
+  double T_;
+  double sigma_;
+  double maturity_;
+  double logK_;
+  double stdDev_;    // σ√T
+  double invStdDev_; // 1 / (σ√T)
+  double halfVarT_;  // ½σ²T
+  bool isCall_;
+  bool live_; // T > 0 and σ > 0; otherwise the price is intrinsic
+};
+
+// Structure-of-arrays book of prepared options, requoted in one pass.
+//
+// Only the per-tick market inputs (forward and discount factor) are read
+// besides the cached invariants; calls and puts share one expression with
+// the sign flipped, so the loop has no type branch. Precision::Fast uses
+// fastmath::log and fastmath::normCDF as in Black76::priceBatch.
+class PreparedOptionBook {
+public:
+  void add(const PreparedOption &option);
+  void add(const EuropeanBondOption &option, double sigma) {
+    add(PreparedOption(option, sigma));
+  }
+  void reserve(std::size_t n);
+  std::size_t size() const { return strike_.size(); }
+
+  // forwards, dfs and out must all have size() elements
+  void requote(QUANT_SPAN<const double> forwards, QUANT_SPAN<const double> dfs,
+               QUANT_SPAN<double> out,
+               Precision precision = kDefaultPrecision) const;
+
+  // Forwards and discount factors read from the curve with batched lookups
+  void requote(const DiscountCurve &curve, QUANT_SPAN<double> out,
+               Precision precision = kDefaultPrecision);
+
+private:
+  std::vector<double> strike_;
+  std::vector<double> logK_;
+  std::vector<double> stdDev_;
+  std::vector<double> invStdDev_;
+  std::vector<double> halfVarT_;
+  std::vector<std::uint8_t> isCall_;
+  std::vector<std::uint8_t> live_;
+  std::vector<double> expiry_;
+  std::vector<double> maturity_;
+
+  // Scratch for the curve overload
+  std::vector<double> forwards_;
+  std::vector<double> dfs_;
+};
+
+} // namespace quant
@@ -0,0 +1,111 @@
+#include "RateOptionBook.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace quant {
+
+std::size_t CapFloorBook::add(const CapFloor &cap, double vol,
+                              VolatilityType volType) {
+  Strip &strip = volType == VolatilityType::Normal ? normal_ : lognormal_;
+  const bool isCall = cap.type() == CapFloor::Type::Cap;
+  const double weight = cap.notional() * cap.accrual();
+  for (std::size_t j = 0; j < cap.caplets(); ++j) {
+    strip.batch.push_back(0.0, cap.strike(), cap.fixingTimes()[j], vol, 0.0,
+                          isCall);
+    strip.payment.push_back(cap.paymentTimes()[j]);
+    strip.accrual.push_back(cap.accrual());
+    strip.weight.push_back(weight);
+    strip.owner.push_back(count_);
+  }
+  return count_++;
+}
+
+void CapFloorBook::priceStrip(Strip &strip, VolatilityType volType,
+                              const DiscountCurve &curve,
+                              QUANT_SPAN<double> out, Precision precision) {
+  const std::size_t n = strip.owner.size();
+  if (n == 0)
+    return;
+  strip.fixingDfs.resize(n);
+  strip.paymentDfs.resize(n);
+  strip.values.resize(n);
+  curve.df(strip.batch.expiry, strip.fixingDfs, precision);
+  curve.df(strip.payment, strip.paymentDfs, precision);
+
+  for (std::size_t i = 0; i < n; ++i) {
+    strip.batch.forward[i] =
+        (strip.fixingDfs[i] / strip.paymentDfs[i] - 1.0) / strip.accrual[i];
+    strip.batch.df[i] = strip.paymentDfs[i];
+  }
+  priceOptionBatch(volType, strip.batch, strip.values, precision);
+
+  for (std::size_t i = 0; i < n; ++i) {
+    out[strip.owner[i]] += strip.weight[i] * strip.values[i];
+  }
+}
+
+void CapFloorBook::price(const DiscountCurve &curve, QUANT_SPAN<double> out,
+                         Precision precision) {
+  if (out.size() != size()) {
+    throw std::invalid_argument("Output size must match number of caps");
+  }
+  std::fill(out.begin(), out.end(), 0.0);
+  priceStrip(lognormal_, VolatilityType::Lognormal, curve, out, precision);
+  priceStrip(normal_, VolatilityType::Normal, curve, out, precision);
+}
+
+std::size_t SwaptionBook::add(const Swaption &swaption, double vol,
+                              VolatilityType volType) {
+  const Swap &swap = swaption.underlying();
+  swaps_.add(swap);
+  expiries_.push_back(swaption.expiry());
+  strikes_.push_back(swap.fixedRate());
+  vols_.push_back(vol);
+  notionals_.push_back(swap.notional());
+  starts_.push_back(swap.start());
+  maturities_.push_back(swap.maturity());
+  isPayer_.push_back(swaption.isPayer() ? 1 : 0);
+  isNormal_.push_back(volType == VolatilityType::Normal ? 1 : 0);
+  return size() - 1;
+}
+
+void SwaptionBook::price(CurveRegistry &registry, const std::string &curve,
+                         QUANT_SPAN<double> out, Precision precision) {
+  const std::size_t n = size();
+  if (out.size() != n) {
+    throw std::invalid_argument("Output size must match number of swaptions");
+  }
+  const std::vector<double> &annuities = swaps_.annuities(registry, curve);
+  const DiscountCurve &c = registry.curve(curve);
+  startDfs_.resize(n);
+  maturityDfs_.resize(n);
+  c.df(starts_, startDfs_, precision);
+  c.df(maturities_, maturityDfs_, precision);
+
+  // One kernel call per volatility type
+  for (std::uint8_t normal : {0, 1}) {
+    index_.clear();
+    batch_.clear();
+    for (std::size_t i = 0; i < n; ++i) {
+      if (isNormal_[i] != normal)
+        continue;
+      const double annuity = annuities[i];
+      const double floatLeg = notionals_[i] * (startDfs_[i] - maturityDfs_[i]);
+      const double forward = annuity != 0.0 ? floatLeg / annuity : 0.0;
+      batch_.push_back(forward, strikes_[i], expiries_[i], vols_[i], annuity,
+                       isPayer_[i] != 0);
+      index_.push_back(i);
+    }
+    if (index_.empty())
+      continue;
+    values_.resize(index_.size());
+    priceOptionBatch(normal ? VolatilityType::Normal
+                            : VolatilityType::Lognormal,
+                     batch_, values_, precision);
+    for (std::size_t k = 0; k < index_.size(); ++k) {
+      out[index_[k]] = values_[k];
+    }
+  }
+}
+
+} // namespace quant
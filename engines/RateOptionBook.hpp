@@ -0,0 +1,96 @@
+#pragma once
+#include "../core/CurveRegistry.hpp"
+#include "../core/DiscountCurve.hpp"
+#include "../instruments/CapFloor.hpp"
+#include "../instruments/Swaption.hpp"
+#include "Bachelier.hpp"
+#include "SwapBook.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace quant {
+
+// Book of caps and floors priced caplet-by-caplet in batch.
+//
+// Every caplet of every instrument lives in one SoA strip per volatility
+// type, with strike, fixing time, volatility and call/put flag set at
+// insertion. Pricing does two batched discount-factor lookups per strip
+// (fixing and payment dates), fills forwards and payment discount factors,
+// makes one Black-76 or Bachelier kernel call per strip and sums each
+// instrument's caplets, which are contiguous.
+class CapFloorBook {
+public:
+  std::size_t add(const CapFloor &cap, double vol,
+                  VolatilityType volType = VolatilityType::Lognormal);
+  std::size_t size() const { return count_; }
+  std::size_t caplets() const {
+    return lognormal_.owner.size() + normal_.owner.size();
+  }
+
+  // out must have size() elements
+  void price(const DiscountCurve &curve, QUANT_SPAN<double> out,
+             Precision precision = kDefaultPrecision);
+
+private:
+  struct Strip {
+    Black76Batch batch; // forward and df refreshed by every price() call
+    std::vector<double> payment;
+    std::vector<double> accrual;
+    std::vector<double> weight; // notional * τ
+    std::vector<std::size_t> owner;
+
+    // Scratch
+    std::vector<double> fixingDfs;
+    std::vector<double> paymentDfs;
+    std::vector<double> values;
+  };
+
+  Strip lognormal_;
+  Strip normal_;
+  std::size_t count_ = 0;
+
+  void priceStrip(Strip &strip, VolatilityType volType,
+                  const DiscountCurve &curve, QUANT_SPAN<double> out,
+                  Precision precision);
+};
+
+// Book of European swaptions priced off SwapBook's cached annuities.
+//
+// The underlying swaps are held in a SwapBook, so annuities against a
+// registry curve are only recomputed when that curve's version changes.
+// Forward swap rates need the start and maturity discount factors (two
+// batched lookups), after which each volatility type is one kernel call
+// with the annuity in place of the discount factor.
+class SwaptionBook {
+public:
+  std::size_t add(const Swaption &swaption, double vol,
+                  VolatilityType volType = VolatilityType::Lognormal);
+  std::size_t size() const { return expiries_.size(); }
+
+  void price(CurveRegistry &registry, const std::string &curve,
+             QUANT_SPAN<double> out, Precision precision = kDefaultPrecision);
+
+  const SwapBook &swaps() const { return swaps_; }
+
+private:
+  SwapBook swaps_;
+  std::vector<double> expiries_;
+  std::vector<double> strikes_;
+  std::vector<double> vols_;
+  std::vector<double> notionals_;
+  std::vector<double> starts_;
+  std::vector<double> maturities_;
+  std::vector<std::uint8_t> isPayer_;
+  std::vector<std::uint8_t> isNormal_;
+
+  // Scratch
+  std::vector<double> startDfs_;
+  std::vector<double> maturityDfs_;
+  std::vector<std::size_t> index_;
+  Black76Batch batch_;
+  std::vector<double> values_;
+};
+
+} // namespace quant
@@ -0,0 +1,140 @@
+#include "RevaluationEngine.hpp"
+#include "../core/Parallel.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace quant {
+
+RevaluationEngine::RevaluationEngine(CurveRegistry &registry,
+                                     std::size_t threads)
+    : registry_(registry), threads_(threads) {}
+
+RevaluationEngine::PositionId
+RevaluationEngine::addPosition(Bond bond, double quantity,
+                               const std::string &curve) {
+  CurveRegistry::CurveId curveId = registry_.id(curve);
+  double price = bond.price(registry_.curve(curve));
+
+  PositionId id = positions_.size();
+  double maturity = bond.maturity();
+  positions_.push_back({std::move(bond), quantity, curveId, price});
+
+  CurveBook &book = books_[curveId];
+  book.name = curve;
+  auto it = std::upper_bound(book.maturities.begin(), book.maturities.end(),
+                             maturity);
+  auto offset = it - book.maturities.begin();
+  book.maturities.insert(it, maturity);
+  book.ids.insert(book.ids.begin() + offset, id);
+
+  book.total += quantity * price;
+  total_ += quantity * price;
+  return id;
+}
+
+void RevaluationEngine::setQuantity(PositionId id, double quantity) {
+  Position &pos = positions_.at(id);
+  double change = (quantity - pos.quantity) * pos.price;
+  pos.quantity = quantity;
+  books_[pos.curve].total += change;
+  total_ += change;
+}
+
+std::size_t RevaluationEngine::updateCurve(const std::string &curve,
+                                           DiscountCurve updated,
+                                           double changedFrom) {
+  registry_.update(curve, std::move(updated));
+  return onCurveUpdate(curve, changedFrom);
+}
+
+std::size_t RevaluationEngine::onCurveUpdate(const std::string &curve,
+                                             double changedFrom) {
+  affected_.clear();
+  curves_.clear();
+
+  collect(registry_.id(curve), changedFrom);
+  for (const auto &name : registry_.downstream(curve)) {
+    collect(registry_.id(name), 0.0);
+  }
+
+  reprice();
+  return affected_.size();
+}
+
+void RevaluationEngine::revalueAll() {
+  affected_.clear();
+  curves_.clear();
+  for (auto &[curveId, book] : books_) {
+    collect(curveId, 0.0);
+  }
+  reprice();
+
+  // Rebuild totals from the stored prices rather than from deltas
+  total_ = 0.0;
+  for (auto &[curveId, book] : books_) {
+    book.total = 0.0;
+    for (PositionId id : book.ids) {
+      book.total += positions_[id].quantity * positions_[id].price;
+    }
+    total_ += book.total;
+  }
+}
+
+double RevaluationEngine::total(const std::string &curve) const {
+  auto it = books_.find(registry_.id(curve));
+  return it == books_.end() ? 0.0 : it->second.total;
+}
+
+double RevaluationEngine::value(PositionId id) const {
+  const Position &pos = positions_.at(id);
+  return pos.quantity * pos.price;
+}
+
+void RevaluationEngine::collect(CurveRegistry::CurveId curve,
+                                double changedFrom) {
+  auto it = books_.find(curve);
+  if (it == books_.end())
+    return;
+  const CurveBook &book = it->second;
+
+  // Registry lookups (and any lazy rebuilds) happen here, on this thread
+  const DiscountCurve *discount = &registry_.curve(book.name);
+
+  // Pillars after changedFrom moved, which also moves the segment leading up
+  // to the first of them: only maturities up to the last pillar at or
+  // before changedFrom see an unchanged curve
+  double unchangedTo = 0.0;
+  for (const ZeroQuote &q : discount->pillars()) {
+    if (q.time > changedFrom)
+      break;
+    unchangedTo = q.time;
+  }
+  auto first = std::upper_bound(book.maturities.begin(), book.maturities.end(),
+                                unchangedTo);
+  auto begin = static_cast<std::size_t>(first - book.maturities.begin());
+  for (std::size_t i = begin; i < book.ids.size(); ++i) {
+    affected_.push_back(book.ids[i]);
+    curves_.push_back(discount);
+  }
+}
+
+void RevaluationEngine::reprice() {
+  prices_.resize(affected_.size());
+  parallelFor(
+      affected_.size(),
+      [this](std::size_t k) {
+        prices_[k] = positions_[affected_[k]].bond.price(*curves_[k]);
+      },
+      threads_);
+
+  // Apply the changes serially so totals stay deterministic
+  for (std::size_t k = 0; k < affected_.size(); ++k) {
+    Position &pos = positions_[affected_[k]];
+    double change = pos.quantity * (prices_[k] - pos.price);
+    pos.price = prices_[k];
+    books_[pos.curve].total += change;
+    total_ += change;
+  }
+}
+
+} // namespace quant
@@ -0,0 +1,86 @@
+#pragma once
+#include "../core/CurveRegistry.hpp"
+#include "../instruments/Bond.hpp"
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace quant {
+
+// Incremental mark-to-market of a bond book against a CurveRegistry.
+//
+// Positions are indexed by the curve they discount on and, within a curve,
+// by maturity. When a curve changes only the positions on that curve (and on
+// curves derived from it) are repriced, in parallel, and the difference to
+// their previous value is applied to the running totals. If the caller knows
+// only pillars after changedFrom moved, positions maturing on or before the
+// last pillar at or before changedFrom are skipped as well: under log-linear
+// interpolation a moved pillar changes its whole preceding segment, so that
+// earlier pillar is the last point where the curve is known to be unchanged.
+// The cost of an update then scales with the affected positions rather than
+// the book.
+//
+// Like the registry, the engine is driven from a single thread.
+class RevaluationEngine {
+public:
+  using PositionId = std::size_t;
+
+  // The registry must outlive the engine
+  explicit RevaluationEngine(CurveRegistry &registry, std::size_t threads = 0);
+
+  // Add a position and price it against the current curve
+  PositionId addPosition(Bond bond, double quantity, const std::string &curve);
+  void setQuantity(PositionId id, double quantity);
+
+  // Replace an input curve in the registry and revalue dependents. Returns
+  // the number of positions repriced. changedFrom: pillars at or before it
+  // are unchanged.
+  std::size_t updateCurve(const std::string &curve, DiscountCurve updated,
+                          double changedFrom = 0.0);
+
+  // Revalue after a curve was changed in the registry directly. Curves
+  // derived from it are always treated as changed everywhere.
+  std::size_t onCurveUpdate(const std::string &curve, double changedFrom = 0.0);
+
+  // Reprice everything and recompute totals from scratch (clears the
+  // rounding that accumulates from many incremental updates)
+  void revalueAll();
+
+  double total() const { return total_; }
+  double total(const std::string &curve) const; // positions on one curve
+  double value(PositionId id) const;            // quantity * price
+  std::size_t size() const { return positions_.size(); }
+
+private:
+  struct Position {
+    Bond bond;
+    double quantity;
+    CurveRegistry::CurveId curve;
+    double price = 0.0;
+  };
+
+  // Positions on one curve, sorted by maturity
+  struct CurveBook {
+    std::string name;
+    std::vector<double> maturities;
+    std::vector<PositionId> ids;
+    double total = 0.0;
+  };
+
+  CurveRegistry &registry_;
+  std::size_t threads_;
+  std::vector<Position> positions_;
+  std::unordered_map<CurveRegistry::CurveId, CurveBook> books_;
+  double total_ = 0.0;
+
+  // Scratch reused across updates
+  std::vector<PositionId> affected_;
+  std::vector<const DiscountCurve *> curves_;
+  std::vector<double> prices_;
+
+  void collect(CurveRegistry::CurveId curve, double changedFrom);
+  void reprice();
+};
+
+} // namespace quant
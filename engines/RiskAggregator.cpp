@@ -0,0 +1,138 @@
+#include "RiskAggregator.hpp"
+#include "../core/Reduction.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace quant {
+
+namespace {
+
+constexpr std::size_t kMinRecordsPerPartition = 16384;
+constexpr std::size_t kMaxPartitions = 128;
+constexpr std::size_t kPartialBudgetBytes = std::size_t{64} << 20;
+
+} // namespace
+
+RiskRecord RiskRecord::fromMoments(const Sensitivity::Moments &mo,
+                                   double quantity, double maturity,
+                                   std::uint32_t issuer,
+                                   std::uint32_t currency) {
+  double duration = mo.price == 0.0 ? 0.0 : -mo.delta / mo.price;
+  double convexity = mo.price == 0.0 ? 0.0 : mo.gamma / mo.price;
+  return {maturity,
+          issuer,
+          currency,
+          quantity * mo.price,
+          -quantity * mo.delta * 0.0001,
+          duration,
+          convexity};
+}
+
+RiskCube::RiskCube(std::size_t tenors, std::size_t issuers,
+                   std::size_t currencies)
+    : tenors_(tenors), issuers_(issuers), currencies_(currencies),
+      cells_(tenors * issuers * currencies) {}
+
+RiskCell RiskCube::total() const {
+  RiskCell sum;
+  for (std::size_t c = 0; c < currencies_; ++c) {
+    sum += currency(c);
+  }
+  return sum;
+}
+
+RiskCell RiskCube::currency(std::size_t currency) const {
+  RiskCell sum;
+  for (std::size_t i = 0; i < issuers_; ++i) {
+    sum += issuer(currency, i);
+  }
+  return sum;
+}
+
+RiskCell RiskCube::issuer(std::size_t currency, std::size_t issuer) const {
+  RiskCell sum;
+  for (std::size_t t = 0; t < tenors_; ++t) {
+    sum += at(currency, issuer, t);
+  }
+  return sum;
+}
+
+std::vector<RiskCell> RiskCube::byTenor() const {
+  std::vector<RiskCell> sums(tenors_);
+  for (std::size_t c = 0; c < currencies_; ++c) {
+    for (std::size_t i = 0; i < issuers_; ++i) {
+      for (std::size_t t = 0; t < tenors_; ++t) {
+        sums[t] += at(c, i, t);
+      }
+    }
+  }
+  return sums;
+}
+
+RiskAggregator::RiskAggregator(TenorBuckets tenors, std::size_t issuers,
+                               std::size_t currencies, std::size_t threads)
+    : tenors_(std::move(tenors)), issuers_(issuers), currencies_(currencies),
+      threads_(threads) {
+  if (issuers_ == 0 || currencies_ == 0) {
+    throw std::invalid_argument(
+        "RiskAggregator needs at least one issuer and currency");
+  }
+}
+
+RiskCube RiskAggregator::aggregate(QUANT_SPAN<const RiskRecord> records) const {
+  const std::size_t n = records.size();
+  const std::size_t cells = tenors_.size() * issuers_ * currencies_;
+
+  // Partition count depends only on the input and cube sizes: enough
+  // partitions to keep every thread busy, few enough that the partial cubes
+  // stay within a fixed memory budget
+  std::size_t partitions = (n + kMinRecordsPerPartition - 1) /
+                           kMinRecordsPerPartition;
+  partitions = std::min(partitions, kMaxPartitions);
+  partitions = std::min(
+      partitions,
+      std::max<std::size_t>(1, kPartialBudgetBytes / (cells * sizeof(RiskCell))));
+  partitions = std::max<std::size_t>(1, partitions);
+  const std::size_t blockSize = (n + partitions - 1) / partitions;
+
+  RiskCube empty(tenors_.size(), issuers_, currencies_);
+  if (n == 0)
+    return empty;
+
+  return reproducibleReduce(
+      n, blockSize,
+      [&](std::size_t begin, std::size_t end) {
+        RiskCube partial = empty;
+        accumulate(partial, records, begin, end);
+        return partial;
+      },
+      [](RiskCube &into, const RiskCube &from) {
+        for (std::size_t c = 0; c < into.cells_.size(); ++c) {
+          into.cells_[c] += from.cells_[c];
+        }
+      },
+      RiskCube(0, 0, 0), threads_);
+}
+
+void RiskAggregator::accumulate(RiskCube &cube,
+                                QUANT_SPAN<const RiskRecord> records,
+                                std::size_t begin, std::size_t end) const {
+  for (std::size_t k = begin; k < end; ++k) {
+    const RiskRecord &r = records[k];
+    if (r.issuer >= issuers_ || r.currency >= currencies_) {
+      throw std::invalid_argument(
+          "RiskRecord issuer or currency index out of range");
+    }
+    std::size_t cell =
+        (r.currency * issuers_ + r.issuer) * cube.tenors_ +
+        tenors_.index(r.maturity);
+    RiskCell &dst = cube.cells_[cell];
+    dst.marketValue += r.marketValue;
+    dst.dv01 += r.dv01;
+    dst.durationWeight += r.marketValue * r.duration;
+    dst.convexityWeight += r.marketValue * r.convexity;
+    ++dst.count;
+  }
+}
+
+} // namespace quant
@@ -0,0 +1,110 @@
+#pragma once
+#include "../core/DiscountCurve.hpp"
+#include "../core/TenorBuckets.hpp"
+#include "Sensitivity.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace quant {
+
+// Per-instrument risk as produced by Sensitivity / Bond::yieldRisk, tagged
+// with the keys it is bucketed by. Issuer and currency are dense indices
+// assigned by the caller.
+struct RiskRecord {
+  double maturity;
+  std::uint32_t issuer;
+  std::uint32_t currency;
+  double marketValue;
+  double dv01;
+  double duration;  // modified duration
+  double convexity; // (1/P) ∂²P/∂y²
+
+  // Scale a single-unit yield-risk result to a position of `quantity`
+  static RiskRecord fromMoments(const Sensitivity::Moments &mo,
+                                double quantity, double maturity,
+                                std::uint32_t issuer, std::uint32_t currency);
+};
+
+// Aggregated risk for one bucket. Duration and convexity are kept as
+// market-value weighted sums so buckets can be merged by plain addition.
+struct RiskCell {
+  double marketValue = 0.0;
+  double dv01 = 0.0;
+  double durationWeight = 0.0;  // Σ MV * duration
+  double convexityWeight = 0.0; // Σ MV * convexity
+  std::size_t count = 0;
+
+  double duration() const {
+    return marketValue == 0.0 ? 0.0 : durationWeight / marketValue;
+  }
+  double convexity() const {
+    return marketValue == 0.0 ? 0.0 : convexityWeight / marketValue;
+  }
+
+  RiskCell &operator+=(const RiskCell &other) {
+    marketValue += other.marketValue;
+    dv01 += other.dv01;
+    durationWeight += other.durationWeight;
+    convexityWeight += other.convexityWeight;
+    count += other.count;
+    return *this;
+  }
+};
+
+// Dense currency × issuer × tenor histogram with roll-ups
+class RiskCube {
+public:
+  RiskCube(std::size_t tenors, std::size_t issuers, std::size_t currencies);
+
+  const RiskCell &at(std::size_t currency, std::size_t issuer,
+                     std::size_t tenor) const {
+    return cells_[(currency * issuers_ + issuer) * tenors_ + tenor];
+  }
+
+  RiskCell total() const;
+  RiskCell currency(std::size_t currency) const;
+  RiskCell issuer(std::size_t currency, std::size_t issuer) const;
+  std::vector<RiskCell> byTenor() const; // summed over issuers and currencies
+
+  std::size_t tenors() const { return tenors_; }
+  std::size_t issuers() const { return issuers_; }
+  std::size_t currencies() const { return currencies_; }
+
+private:
+  friend class RiskAggregator;
+
+  std::size_t tenors_;
+  std::size_t issuers_;
+  std::size_t currencies_;
+  std::vector<RiskCell> cells_;
+};
+
+// Bins per-instrument risk into the cube in a single parallel pass.
+//
+// The input is cut into partitions whose boundaries depend only on the
+// number of records and the cube size (not on the thread count). Each
+// partition is binned into a private partial cube and the partials are
+// merged along a fixed tree (see Reduction.hpp), so the result is bitwise
+// reproducible across thread counts and runs. Records with an issuer or
+// currency outside the configured ranges are rejected.
+class RiskAggregator {
+public:
+  RiskAggregator(TenorBuckets tenors, std::size_t issuers,
+                 std::size_t currencies, std::size_t threads = 0);
+
+  RiskCube aggregate(QUANT_SPAN<const RiskRecord> records) const;
+
+  const TenorBuckets &tenors() const { return tenors_; }
+
+private:
+  TenorBuckets tenors_;
+  std::size_t issuers_;
+  std::size_t currencies_;
+  std::size_t threads_;
+
+  void accumulate(RiskCube &cube, QUANT_SPAN<const RiskRecord> records,
+                  std::size_t begin, std::size_t end) const;
+};
+
+} // namespace quant
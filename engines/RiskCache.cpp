@@ -0,0 +1,88 @@
+#include "RiskCache.hpp"
+#include "../core/Parallel.hpp"
+
+namespace quant {
+
+RiskCache::RiskCache(DiscountCurve curve, Compounding compounding,
+                     TenorBuckets buckets, std::size_t threads)
+    : curve_(std::move(curve)), compounding_(compounding),
+      buckets_(std::move(buckets)), threads_(threads),
+      totals_(emptyTotals()) {}
+
+std::size_t RiskCache::add(const Bond &bond, double quantity) {
+  RiskTrade trade{bond, quantity};
+  return add(QUANT_SPAN<const RiskTrade>(&trade, 1));
+}
+
+std::size_t RiskCache::add(QUANT_SPAN<const RiskTrade> trades) {
+  std::size_t first = book_.size();
+  for (const auto &trade : trades) {
+    PositionRisk risk = evaluate(trade);
+    book_.push_back(trade);
+    risk_.push_back(risk);
+    accumulate(totals_, risk);
+  }
+  return first;
+}
+
+void RiskCache::setCurve(DiscountCurve curve) {
+  curve_ = std::move(curve);
+  parallelFor(
+      book_.size(), [this](std::size_t i) { risk_[i] = evaluate(book_[i]); },
+      threads_);
+
+  // Aggregate in book order so totals do not depend on the thread count
+  totals_ = emptyTotals();
+  for (const auto &risk : risk_) {
+    accumulate(totals_, risk);
+  }
+}
+
+RiskTotals RiskCache::marginal(QUANT_SPAN<const RiskTrade> candidates) const {
+  RiskTotals result = emptyTotals();
+  for (const auto &trade : candidates) {
+    accumulate(result, evaluate(trade));
+  }
+  return result;
+}
+
+RiskTotals RiskCache::whatIf(QUANT_SPAN<const RiskTrade> candidates) const {
+  RiskTotals result = totals_;
+  for (const auto &trade : candidates) {
+    accumulate(result, evaluate(trade));
+  }
+  return result;
+}
+
+std::vector<RiskTotals>
+RiskCache::whatIfEach(QUANT_SPAN<const RiskTrade> candidates) const {
+  std::vector<RiskTotals> results(candidates.size(), totals_);
+  for (std::size_t i = 0; i < candidates.size(); ++i) {
+    accumulate(results[i], evaluate(candidates[i]));
+  }
+  return results;
+}
+
+RiskCache::PositionRisk RiskCache::evaluate(const RiskTrade &trade) const {
+  Sensitivity::Moments mo = trade.bond.yieldRisk(curve_, compounding_);
+  return {trade.quantity * trade.bond.price(curve_),
+          -trade.quantity * mo.delta * 0.0001, trade.quantity * mo.gamma,
+          buckets_.index(trade.bond.maturity())};
+}
+
+RiskTotals RiskCache::emptyTotals() const {
+  RiskTotals totals;
+  totals.dv01Buckets.assign(buckets_.size(), 0.0);
+  totals.convexityBuckets.assign(buckets_.size(), 0.0);
+  return totals;
+}
+
+void RiskCache::accumulate(RiskTotals &totals, const PositionRisk &risk) {
+  totals.marketValue += risk.marketValue;
+  totals.dv01 += risk.dv01;
+  totals.dollarConvexity += risk.dollarConvexity;
+  totals.dv01Buckets[risk.bucket] += risk.dv01;
+  totals.convexityBuckets[risk.bucket] += risk.dollarConvexity;
+}
+
+} // namespace quant
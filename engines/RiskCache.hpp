@@ -0,0 +1,84 @@
+#pragma once
+#include "../core/DiscountCurve.hpp"
+#include "../core/TenorBuckets.hpp"
+#include "../instruments/Bond.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace quant {
+
+// Candidate (or booked) trade for risk purposes
+struct RiskTrade {
+  Bond bond;
+  double quantity;
+};
+
+// Aggregated yield risk, in total and per maturity bucket
+struct RiskTotals {
+  double marketValue = 0.0;     // Σ q * price
+  double dv01 = 0.0;            // Σ q * dv01
+  double dollarConvexity = 0.0; // Σ q * ∂²P/∂y²
+  std::vector<double> dv01Buckets;
+  std::vector<double> convexityBuckets; // dollar convexity per bucket
+
+  // Portfolio convexity (1/MV) * Σ q ∂²P/∂y²; 0 for an empty book
+  double convexity() const {
+    return marketValue == 0.0 ? 0.0 : dollarConvexity / marketValue;
+  }
+};
+
+// Book-level DV01/convexity cache for what-if analysis.
+//
+// The risk of every booked position is computed once (and again only when
+// the curve changes) and kept both per position and aggregated. A what-if
+// query prices only the candidate trades and adds their contributions to
+// the cached aggregates, so its cost is independent of the book size.
+class RiskCache {
+public:
+  RiskCache(DiscountCurve curve, Compounding compounding,
+            TenorBuckets buckets = TenorBuckets(), std::size_t threads = 0);
+
+  // Book trades; returns the index of the first one added
+  std::size_t add(const Bond &bond, double quantity);
+  std::size_t add(QUANT_SPAN<const RiskTrade> trades);
+
+  // Reprice the whole book's risk against a new curve (in parallel)
+  void setCurve(DiscountCurve curve);
+
+  const RiskTotals &totals() const { return totals_; }
+  std::size_t size() const { return risk_.size(); }
+
+  // Contribution of the candidates alone, as a basket
+  RiskTotals marginal(QUANT_SPAN<const RiskTrade> candidates) const;
+
+  // Book plus the whole basket of candidates
+  RiskTotals whatIf(QUANT_SPAN<const RiskTrade> candidates) const;
+
+  // Book plus each candidate on its own, one result per candidate
+  std::vector<RiskTotals>
+  whatIfEach(QUANT_SPAN<const RiskTrade> candidates) const;
+
+  const TenorBuckets &buckets() const { return buckets_; }
+
+private:
+  struct PositionRisk {
+    double marketValue;
+    double dv01;
+    double dollarConvexity;
+    std::size_t bucket;
+  };
+
+  DiscountCurve curve_;
+  Compounding compounding_;
+  TenorBuckets buckets_;
+  std::size_t threads_;
+  std::vector<RiskTrade> book_;
+  std::vector<PositionRisk> risk_;
+  RiskTotals totals_;
+
+  PositionRisk evaluate(const RiskTrade &trade) const;
+  RiskTotals emptyTotals() const;
+  static void accumulate(RiskTotals &totals, const PositionRisk &risk);
+};
+
+} // namespace quant
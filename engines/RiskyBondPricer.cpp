@@ -0,0 +1,117 @@
+#include "RiskyBondPricer.hpp"
+#include "../core/Parallel.hpp"
+#include <stdexcept>
+#include <utility>
+
+namespace quant {
+
+namespace {
+
+void checkRecovery(double recovery) {
+  if (!(recovery >= 0.0) || !(recovery <= 1.0)) {
+    throw std::invalid_argument("Recovery rate must be in [0, 1]");
+  }
+}
+
+// Surviving cash flows plus recovery over the same sorted dates;
+// survival is scratch for S(t_k)
+double riskyValue(QUANT_SPAN<const double> times,
+                  QUANT_SPAN<const double> amounts,
+                  QUANT_SPAN<const double> dfs, const HazardCurve &hazard,
+                  double recoveryAmount, std::vector<double> &survival) {
+  survival.resize(times.size());
+  hazard.survival(times, survival);
+  double value = 0.0;
+  double previous = 1.0;
+  for (std::size_t k = 0; k < times.size(); ++k) {
+    const double s = survival[k];
+    value += dfs[k] * (amounts[k] * s + recoveryAmount * (previous - s));
+    previous = s;
+  }
+  return value;
+}
+
+} // namespace
+
+double RiskyBondPricer::price(const Bond &bond, const DiscountCurve &base,
+                              const HazardCurve &hazard, double recovery) {
+  checkRecovery(recovery);
+  const std::vector<CashFlow> &cfs = bond.cashFlows();
+  std::vector<double> times(cfs.size()), amounts(cfs.size()),
+      dfs(cfs.size()), survival;
+  for (std::size_t k = 0; k < cfs.size(); ++k) {
+    times[k] = cfs[k].time;
+    amounts[k] = cfs[k].amount;
+  }
+  base.df(times, dfs);
+  return riskyValue(times, amounts, dfs, hazard, recovery * bond.face(),
+                    survival);
+}
+
+std::size_t RiskyBondBook::addIssuer(HazardCurve hazard, double recovery) {
+  checkRecovery(recovery);
+  hazards_.push_back(std::move(hazard));
+  recoveries_.push_back(recovery);
+  return hazards_.size() - 1;
+}
+
+void RiskyBondBook::setIssuer(std::size_t issuer, HazardCurve hazard,
+                              double recovery) {
+  if (issuer >= hazards_.size()) {
+    throw std::out_of_range("Unknown issuer");
+  }
+  checkRecovery(recovery);
+  hazards_[issuer] = std::move(hazard);
+  recoveries_[issuer] = recovery;
+}
+
+std::size_t RiskyBondBook::add(const Bond &bond, double quantity,
+                               std::size_t issuer) {
+  if (issuer >= hazards_.size()) {
+    throw std::out_of_range("Unknown issuer");
+  }
+  offsets_.push_back(flows_.flows());
+  flows_.add(bond.cashFlows());
+  quantities_.push_back(quantity);
+  faces_.push_back(bond.face());
+  issuerOf_.push_back(issuer);
+  hasBase_ = false; // new flows have no discount factors yet
+  return size() - 1;
+}
+
+void RiskyBondBook::setBaseCurve(const DiscountCurve &curve) {
+  dfs_.resize(flows_.flows());
+  for (std::size_t p = 0; p < size(); ++p) {
+    QUANT_SPAN<const double> times = flows_.times(p);
+    curve.df(times, QUANT_SPAN<double>(dfs_.data() + offsets_[p],
+                                       times.size()));
+  }
+  hasBase_ = true;
+}
+
+void RiskyBondBook::price(QUANT_SPAN<double> out) const {
+  if (out.size() != size()) {
+    throw std::invalid_argument("Output size must match number of positions");
+  }
+  if (!hasBase_) {
+    throw std::runtime_error(
+        "RiskyBondBook: setBaseCurve() must run after adding positions");
+  }
+  parallelForRange(
+      size(),
+      [&](std::size_t begin, std::size_t end) {
+        std::vector<double> survival;
+        for (std::size_t p = begin; p < end; ++p) {
+          QUANT_SPAN<const double> times = flows_.times(p);
+          QUANT_SPAN<const double> dfs(dfs_.data() + offsets_[p],
+                                       times.size());
+          const std::size_t issuer = issuerOf_[p];
+          out[p] = quantities_[p] *
+                   riskyValue(times, flows_.amounts(p), dfs, hazards_[issuer],
+                              recoveries_[issuer] * faces_[p], survival);
+        }
+      },
+      threads_);
+}
+
+} // namespace quant
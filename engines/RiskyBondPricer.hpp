@@ -0,0 +1,60 @@
+#pragma once
+#include "../core/CashFlowBlock.hpp"
+#include "../core/DiscountCurve.hpp"
+#include "../core/HazardCurve.hpp"
+#include "../instruments/Bond.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace quant {
+
+// Defaultable bond pricing off a risk-free curve and a hazard curve:
+//   V = Σ CF_k P(t_k) S(t_k) + R F Σ P(t_k) (S(t_{k-1}) - S(t_k))
+// i.e. surviving cash flows plus recovery of face R F, paid on the first
+// cash-flow date after default. Discount factors come from one batched
+// lookup, survival probabilities from HazardCurve's sorted sweep over the
+// same times, and both legs accumulate in a single pass.
+class RiskyBondPricer {
+public:
+  static double price(const Bond &bond, const DiscountCurve &base,
+                      const HazardCurve &hazard, double recovery);
+};
+
+// Risky bond positions across many issuers sharing one base curve.
+//
+// Discount factors at every cash-flow date are cached by setBaseCurve(), so
+// a credit update (new hazard curve or recovery for an issuer) reprices
+// with survival sweeps only. Positions are priced in parallel.
+class RiskyBondBook {
+public:
+  explicit RiskyBondBook(std::size_t threads = 0) : threads_(threads) {}
+
+  std::size_t addIssuer(HazardCurve hazard, double recovery);
+  void setIssuer(std::size_t issuer, HazardCurve hazard, double recovery);
+
+  // Returns the position index
+  std::size_t add(const Bond &bond, double quantity, std::size_t issuer);
+
+  // Batched discount-factor lookups over every position's cash-flow dates
+  void setBaseCurve(const DiscountCurve &curve);
+
+  // quantity * risky price per position; out must have size() elements
+  void price(QUANT_SPAN<double> out) const;
+
+  std::size_t size() const { return quantities_.size(); }
+  std::size_t issuers() const { return hazards_.size(); }
+
+private:
+  std::size_t threads_;
+  CashFlowBlock flows_;
+  std::vector<double> dfs_; // aligned with flows_, set by setBaseCurve
+  std::vector<std::size_t> offsets_; // first flow of each position
+  std::vector<double> quantities_;
+  std::vector<double> faces_;
+  std::vector<std::size_t> issuerOf_;
+  std::vector<HazardCurve> hazards_;
+  std::vector<double> recoveries_;
+  bool hasBase_ = false;
+};
+
+} // namespace quant
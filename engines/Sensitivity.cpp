@@ -1,60 +1,118 @@
 #include "Sensitivity.hpp"
+#include <algorithm>
 #include <cmath>
+#include <stdexcept>
 
 namespace quant {
 
-double Sensitivity::price(const std::vector<CashFlow> &cashFlows, double yield,
-                          Compounding compounding) {
-  double P = 0.0;
+namespace {
+
+// Recompute the discount factor exactly every so often so the geometric
+// recurrence cannot drift on long monthly schedules
+constexpr std::size_t kResyncInterval = 64;
+
+// Per-yield constants shared by every cash flow:
+//   P(t)   = exp(-c*t),  c = m*ln(1 + y/m)  (c = y for continuous)
+//   dP/dy  = -t * P(t) / (1 + y/m)
+//   d²P/dy² = (t² + t/m) * P(t) / (1 + y/m)²
+struct YieldTerms {
+  double c;       // log growth rate
+  double invBase; // 1 / (1 + y/m), 1 for continuous
+  double invM;    // 1 / m, 0 for continuous
+};
 
-  for (const auto &cf : cashFlows) {
-    double df = discountFactor(cf.time, yield, compounding);
-    P += cf.amount * df;
+YieldTerms yieldTerms(double yield, Compounding compounding) {
+  if (compounding == Compounding::Continuous) {
+    return {yield, 1.0, 0.0};
   }
+  double m = static_cast<double>(compounding);
+  return {m * std::log1p(yield / m), 1.0 / (1.0 + yield / m), 1.0 / m};
+}
 
-  return P;
+// True when times[i] == times[0] + i*h for all i (bulletSchedule output)
+template <typename Times> bool evenlySpaced(const Times &times, double &h) {
+  std::size_t n = times.size();
+  if (n < 3)
+    return false;
+  h = times[1] - times[0];
+  if (!(h > 0.0))
+    return false;
+  for (std::size_t i = 2; i < n; ++i) {
+    double expected = times[0] + static_cast<double>(i) * h;
+    if (std::abs(times[i] - expected) > 1e-12 * std::max(1.0, expected))
+      return false;
+  }
+  return true;
 }
 
-double Sensitivity::priceDelta(const std::vector<CashFlow> &cashFlows,
-                               double yield, Compounding compounding) {
-  // ∂P/∂y = -∑ CFᵢ * tᵢ * (1 + y/m)^(-mtᵢ-1) for discrete compounding
-  // ∂P/∂y = -∑ CFᵢ * tᵢ * e^(-ytᵢ) for continuous compounding
+// Adapter so evenlySpaced works on cash flow vectors without copying times
+struct CashFlowTimes {
+  const std::vector<CashFlow> &cfs;
+  std::size_t size() const { return cfs.size(); }
+  double operator[](std::size_t i) const { return cfs[i].time; }
+};
+
+// Price, ∂P/∂y and ∂²P/∂y² in one pass; times[i] and amount(i) give flow i
+template <typename Times, typename Amount>
+Sensitivity::Moments flowMoments(const Times &times, Amount amount,
+                                 double yield, Compounding compounding) {
+  const YieldTerms yt = yieldTerms(yield, compounding);
 
-  double dP_dy = 0.0;
+  double h = 0.0;
+  const bool regular = evenlySpaced(times, h);
+  const double ratio = regular ? std::exp(-yt.c * h) : 0.0;
 
-  for (const auto &cf : cashFlows) {
-    double delta_df = discountFactorDelta(cf.time, yield, compounding);
-    dP_dy += cf.amount * delta_df;
+  double P = 0.0;
+  double sumT = 0.0;  // ∑ CFᵢ tᵢ Pᵢ
+  double sumT2 = 0.0; // ∑ CFᵢ (tᵢ² + tᵢ/m) Pᵢ
+  double df = 0.0;
+
+  for (std::size_t i = 0; i < times.size(); ++i) {
+    const double t = times[i];
+    df = (regular && i % kResyncInterval != 0) ? df * ratio
+                                               : std::exp(-yt.c * t);
+    const double pv = amount(i) * df;
+    P += pv;
+    sumT += pv * t;
+    sumT2 += pv * t * (t + yt.invM);
   }
 
-  return dP_dy;
+  Sensitivity::Moments mo;
+  mo.price = P;
+  mo.delta = -sumT * yt.invBase;
+  mo.gamma = sumT2 * yt.invBase * yt.invBase;
+  return mo;
 }
 
-double Sensitivity::priceGamma(const std::vector<CashFlow> &cashFlows,
-                               double yield, Compounding compounding) {
-  // ∂²P/∂y² - second derivative
+} // namespace
 
-  double d2P_dy2 = 0.0;
+double Sensitivity::price(const std::vector<CashFlow> &cashFlows, double yield,
+                          Compounding compounding) {
+  return moments(cashFlows, yield, compounding).price;
+}
 
-  for (const auto &cf : cashFlows) {
-    double gamma_df = discountFactorGamma(cf.time, yield, compounding);
-    d2P_dy2 += cf.amount * gamma_df;
-  }
+double Sensitivity::priceDelta(const std::vector<CashFlow> &cashFlows,
+                               double yield, Compounding compounding) {
+  // ∂P/∂y = -∑ CFᵢ * tᵢ * (1 + y/m)^(-mtᵢ-1) for discrete compounding
+  // ∂P/∂y = -∑ CFᵢ * tᵢ * e^(-ytᵢ) for continuous compounding
+  return moments(cashFlows, yield, compounding).delta;
+}
 
-  return d2P_dy2;
+double Sensitivity::priceGamma(const std::vector<CashFlow> &cashFlows,
+                               double yield, Compounding compounding) {
+  // ∂²P/∂y² = ∑ CFᵢ * (tᵢ² + tᵢ/m) * (1 + y/m)^(-mtᵢ-2)
+  return moments(cashFlows, yield, compounding).gamma;
 }
 
 double Sensitivity::modifiedDuration(const std::vector<CashFlow> &cashFlows,
                                      double yield, Compounding compounding) {
-  // Modified Duration = -(1/P) * (∂P/∂y)
+  // Modified Duration = -(1/P) * (∂P/∂y), price and delta from one pass
+  Moments mo = moments(cashFlows, yield, compounding);
 
-  double P = price(cashFlows, yield, compounding);
-  double dP_dy = priceDelta(cashFlows, yield, compounding);
-
-  if (P == 0.0)
+  if (mo.price == 0.0)
     return 0.0;
 
-  return -dP_dy / P;
+  return -mo.delta / mo.price;
 }
 
 double Sensitivity::dv01(const std::vector<CashFlow> &cashFlows, double yield,
@@ -67,58 +125,64 @@ double Sensitivity::dv01(const std::vector<CashFlow> &cashFlows, double yield,
 
 double Sensitivity::convexity(const std::vector<CashFlow> &cashFlows,
                               double yield, Compounding compounding) {
-  // Convexity = (1/P) * (∂²P/∂y²)
-
-  double P = price(cashFlows, yield, compounding);
-  double d2P_dy2 = priceGamma(cashFlows, yield, compounding);
+  // Convexity = (1/P) * (∂²P/∂y²), price and gamma from one pass
+  Moments mo = moments(cashFlows, yield, compounding);
 
-  if (P == 0.0)
+  if (mo.price == 0.0)
     return 0.0;
 
-  return d2P_dy2 / P;
+  return mo.gamma / mo.price;
 }
 
-// Helper functions
-
-double Sensitivity::discountFactor(double time, double yield,
-                                   Compounding compounding) {
-  if (compounding == Compounding::Continuous) {
-    return std::exp(-yield * time);
-  } else {
-    double m = static_cast<double>(compounding);
-    return std::pow(1.0 + yield / m, -m * time);
+void Sensitivity::discountFactors(QUANT_SPAN<const double> times, double yield,
+                                  Compounding compounding,
+                                  QUANT_SPAN<double> out,
+                                  Precision precision) {
+  if (times.size() != out.size()) {
+    throw std::invalid_argument("Output size must match number of times");
   }
-}
 
-double Sensitivity::discountFactorDelta(double time, double yield,
-                                        Compounding compounding) {
-  // First derivative of discount factor with respect to yield
+  const double c = yieldTerms(yield, compounding).c;
+  double h = 0.0;
 
-  if (compounding == Compounding::Continuous) {
-    // d/dy[e^(-yt)] = -t * e^(-yt)
-    return -time * std::exp(-yield * time);
-  } else {
-    // d/dy[(1 + y/m)^(-mt)] = -t * (1 + y/m)^(-mt-1)
-    double m = static_cast<double>(compounding);
-    double base = 1.0 + yield / m;
-    return -time * std::pow(base, -m * time - 1.0);
+  if (evenlySpaced(times, h)) {
+    const double ratio = std::exp(-c * h);
+    for (std::size_t i = 0; i < times.size(); ++i) {
+      out[i] = (i % kResyncInterval == 0) ? std::exp(-c * times[i])
+                                          : out[i - 1] * ratio;
+    }
+    return;
+  }
+
+  // Independent iterations: vectorizable when a SIMD exp is available
+  if (precision == Precision::Fast) {
+    for (std::size_t i = 0; i < times.size(); ++i) {
+      out[i] = fastmath::exp(-c * times[i]);
+    }
+    return;
+  }
+  for (std::size_t i = 0; i < times.size(); ++i) {
+    out[i] = std::exp(-c * times[i]);
   }
 }
 
-double Sensitivity::discountFactorGamma(double time, double yield,
-                                        Compounding compounding) {
-  // Second derivative of discount factor with respect to yield
+Sensitivity::Moments Sensitivity::moments(const std::vector<CashFlow> &cashFlows,
+                                          double yield,
+                                          Compounding compounding) {
+  return flowMoments(
+      CashFlowTimes{cashFlows},
+      [&](std::size_t i) { return cashFlows[i].amount; }, yield, compounding);
+}
 
-  if (compounding == Compounding::Continuous) {
-    // d²/dy²[e^(-yt)] = t² * e^(-yt)
-    return time * time * std::exp(-yield * time);
-  } else {
-    // d²/dy²[(1 + y/m)^(-mt)] = (t² + t/m) * (1 + y/m)^(-mt-2)
-    // More algebraically precise form
-    double m = static_cast<double>(compounding);
-    double base = 1.0 + yield / m;
-    return (time * time + time / m) * std::pow(base, -m * time - 2.0);
+Sensitivity::Moments Sensitivity::moments(QUANT_SPAN<const double> times,
+                                          QUANT_SPAN<const double> amounts,
+                                          double yield,
+                                          Compounding compounding) {
+  if (times.size() != amounts.size()) {
+    throw std::invalid_argument("Times and amounts must have the same size");
   }
+  return flowMoments(
+      times, [&](std::size_t i) { return amounts[i]; }, yield, compounding);
 }
 
-} // namespace quant
\ No newline at end of file
+} // namespace quant
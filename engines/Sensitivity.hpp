@@ -32,18 +32,29 @@ public:
   static double convexity(const std::vector<CashFlow> &cashFlows, double yield,
                           Compounding compounding);
 
-private:
-  // Helper: Calculate discount factor for a given time and yield
-  static double discountFactor(double time, double yield,
-                               Compounding compounding);
-
-  // Helper: Calculate first derivative of discount factor
-  static double discountFactorDelta(double time, double yield,
-                                    Compounding compounding);
-
-  // Helper: Calculate second derivative of discount factor
-  static double discountFactorGamma(double time, double yield,
-                                    Compounding compounding);
+  // Batched flat-yield discount factors: exp(-c*t) with c = m*ln(1 + y/m)
+  // computed once; evenly spaced times use the geometric recurrence
+  // df_{i+1} = df_i * exp(-c*h). out must have the same size as times.
+  // Precision::Fast uses fastmath::exp for the per-time exponentials.
+  static void discountFactors(QUANT_SPAN<const double> times, double yield,
+                              Compounding compounding, QUANT_SPAN<double> out,
+                              Precision precision = kDefaultPrecision);
+
+  // Price and its first two yield derivatives
+  struct Moments {
+    double price = 0.0;
+    double delta = 0.0; // ∂P/∂y
+    double gamma = 0.0; // ∂²P/∂y²
+  };
+
+  // Price, ∂P/∂y and ∂²P/∂y² accumulated in one pass over the cash flows
+  static Moments moments(const std::vector<CashFlow> &cashFlows, double yield,
+                         Compounding compounding);
+
+  // Same over structure-of-arrays flows, e.g. one CashFlowBlock position
+  static Moments moments(QUANT_SPAN<const double> times,
+                         QUANT_SPAN<const double> amounts, double yield,
+                         Compounding compounding);
 };
 
-} // namespace quant
\ No newline at end of file
+} // namespace quant
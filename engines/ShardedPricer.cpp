@@ -0,0 +1,140 @@
+#include "ShardedPricer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+
+namespace quant {
+
+ShardedPricer::ShardedPricer(const std::vector<Bond> &bonds,
+                             const std::vector<double> &quantities,
+                             NumaTopology topology,
+                             std::size_t threadsPerNode)
+    : topology_(std::move(topology)), positions_(bonds.size()) {
+  if (bonds.size() != quantities.size()) {
+    throw std::invalid_argument("One quantity per bond is required");
+  }
+
+  // Contiguous position ranges proportional to each node's CPU count
+  const auto &nodes = topology_.nodes();
+  const std::size_t cpus = topology_.cpuCount();
+  std::size_t assigned = 0;
+  std::size_t cpusBefore = 0;
+  for (std::size_t n = 0; n < nodes.size(); ++n) {
+    cpusBefore += nodes[n].cpus.size();
+    std::size_t end = positions_ * cpusBefore / cpus;
+    Shard shard;
+    shard.node = n;
+    shard.first = assigned;
+    shard.count = end - assigned;
+    shard.threads = threadsPerNode == 0
+                        ? nodes[n].cpus.size()
+                        : std::min(threadsPerNode, nodes[n].cpus.size());
+    shards_.push_back(std::move(shard));
+    assigned = end;
+  }
+
+  // First touch of each shard's arrays from its own node
+  runOnShards(
+      [&](Shard &shard, std::size_t, std::size_t) {
+        std::size_t flows = 0;
+        for (std::size_t p = 0; p < shard.count; ++p) {
+          flows += bonds[shard.first + p].cashFlows().size();
+        }
+        shard.flows.reserve(shard.count, flows);
+        for (std::size_t p = 0; p < shard.count; ++p) {
+          shard.flows.add(bonds[shard.first + p].cashFlows(),
+                          quantities[shard.first + p]);
+        }
+        shard.results.assign(shard.count, 0.0);
+      },
+      true);
+}
+
+double ShardedPricer::price(const DiscountCurve &curve) {
+  // Replicate the curve on every node before any worker reads it
+  runOnShards([&](Shard &shard, std::size_t,
+                  std::size_t) { shard.curve.emplace(curve); },
+              true);
+
+  runOnShards(
+      [](Shard &shard, std::size_t worker, std::size_t workers) {
+        std::size_t begin = shard.count * worker / workers;
+        std::size_t end = shard.count * (worker + 1) / workers;
+        std::vector<double> scratch;
+        shard.flows.price(*shard.curve, begin, end,
+                          QUANT_SPAN<double>(shard.results.data() + begin,
+                                             end - begin),
+                          scratch);
+      },
+      false);
+
+  double total = 0.0;
+  for (const auto &shard : shards_) {
+    for (double v : shard.results) {
+      total += v;
+    }
+  }
+  return total;
+}
+
+double ShardedPricer::value(std::size_t position) const {
+  if (position >= positions_) {
+    throw std::out_of_range("Position index out of range");
+  }
+  for (const auto &shard : shards_) {
+    if (position < shard.first + shard.count)
+      return shard.results[position - shard.first];
+  }
+  return 0.0; // unreachable: shards cover every position
+}
+
+std::vector<double> ShardedPricer::values() const {
+  std::vector<double> all;
+  all.reserve(positions_);
+  for (const auto &shard : shards_) {
+    all.insert(all.end(), shard.results.begin(), shard.results.end());
+  }
+  return all;
+}
+
+template <typename Fn>
+void ShardedPricer::runOnShards(Fn &&fn, bool singleWorker) {
+  std::vector<std::thread> workers;
+  std::vector<std::exception_ptr> errors;
+  std::atomic<bool> allPinned{true};
+
+  std::size_t total = 0;
+  for (const auto &shard : shards_) {
+    total += singleWorker ? 1 : shard.threads;
+  }
+  errors.resize(total);
+
+  std::size_t slot = 0;
+  for (auto &shard : shards_) {
+    const std::size_t count = singleWorker ? 1 : shard.threads;
+    for (std::size_t w = 0; w < count; ++w, ++slot) {
+      workers.emplace_back([&, w, count, slot] {
+        if (!pinCurrentThread(topology_.nodes()[shard.node].cpus))
+          allPinned.store(false);
+        try {
+          fn(shard, w, count);
+        } catch (...) {
+          errors[slot] = std::current_exception();
+        }
+      });
+    }
+  }
+
+  for (auto &w : workers) {
+    w.join();
+  }
+  pinned_ = allPinned.load();
+  for (const auto &e : errors) {
+    if (e)
+      std::rethrow_exception(e);
+  }
+}
+
+} // namespace quant
@@ -0,0 +1,66 @@
+#pragma once
+#include "../core/CashFlowBlock.hpp"
+#include "../core/DiscountCurve.hpp"
+#include "../core/NumaTopology.hpp"
+#include "../instruments/Bond.hpp"
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace quant {
+
+// Bond book split into one shard per NUMA node.
+//
+// Each shard's cash flows (a CashFlowBlock) and result array are allocated
+// and first written by a thread pinned to that node, so under the kernel's
+// first-touch policy their pages live in the node's local memory. Pricing
+// copies the curve once per node (again from a pinned thread) and every
+// node's worker threads read only node-local data. Positions are assigned
+// to shards in contiguous ranges proportional to each node's CPU count.
+//
+// On a single-node machine this is simply a parallel SoA pricer.
+class ShardedPricer {
+public:
+  // threadsPerNode = 0 uses every CPU of each node
+  ShardedPricer(const std::vector<Bond> &bonds,
+                const std::vector<double> &quantities,
+                NumaTopology topology = NumaTopology::detect(),
+                std::size_t threadsPerNode = 0);
+
+  // Price every position (quantity * PV) and return the book total. The
+  // total is summed in position order, independent of the thread layout.
+  double price(const DiscountCurve &curve);
+
+  double value(std::size_t position) const;
+  std::vector<double> values() const;
+
+  std::size_t size() const { return positions_; }
+  std::size_t shards() const { return shards_.size(); }
+  const NumaTopology &topology() const { return topology_; }
+
+  // True if every worker thread was successfully pinned during the last
+  // construction or pricing call
+  bool pinned() const { return pinned_; }
+
+private:
+  struct Shard {
+    std::size_t node;  // index into topology_.nodes()
+    std::size_t first; // first global position
+    std::size_t count;
+    std::size_t threads;
+    CashFlowBlock flows;
+    std::vector<double> results;
+    std::optional<DiscountCurve> curve; // node-local replica
+  };
+
+  NumaTopology topology_;
+  std::vector<Shard> shards_;
+  std::size_t positions_;
+  bool pinned_ = true;
+
+  // Run fn(shard, worker, workers) on every shard's pinned worker threads;
+  // singleWorker limits each shard to one thread (allocation, replication)
+  template <typename Fn> void runOnShards(Fn &&fn, bool singleWorker);
+};
+
+} // namespace quant
@@ -0,0 +1,62 @@
+#include "SwapBook.hpp"
+#include <stdexcept>
+
+namespace quant {
+
+std::size_t SwapBook::add(const Swap &swap) {
+  fixed_.add(swap.annuityFlows());
+  starts_.push_back(swap.start());
+  maturities_.push_back(swap.maturity());
+  notionals_.push_back(swap.notional());
+  rates_.push_back(swap.fixedRate());
+  signs_.push_back(swap.sign());
+  // Cached vectors no longer cover the book
+  cache_.clear();
+  return size() - 1;
+}
+
+void SwapBook::value(const DiscountCurve &curve,
+                     QUANT_SPAN<SwapValuation> out) {
+  const std::size_t n = size();
+  if (out.size() != n) {
+    throw std::invalid_argument("Output size must match number of swaps");
+  }
+  annuities_.resize(n);
+  startDfs_.resize(n);
+  maturityDfs_.resize(n);
+  fixed_.price(curve, 0, n, annuities_, dfScratch_);
+  curve.df(starts_, startDfs_);
+  curve.df(maturities_, maturityDfs_);
+
+  for (std::size_t i = 0; i < n; ++i) {
+    const double annuity = annuities_[i];
+    const double floatLeg = notionals_[i] * (startDfs_[i] - maturityDfs_[i]);
+    const double fixedLeg = rates_[i] * annuity;
+    out[i].annuity = annuity;
+    out[i].floatLeg = floatLeg;
+    out[i].fixedLeg = fixedLeg;
+    out[i].parRate = annuity != 0.0 ? floatLeg / annuity : 0.0;
+    out[i].pv = signs_[i] * (floatLeg - fixedLeg);
+  }
+}
+
+const std::vector<double> &SwapBook::annuities(CurveRegistry &registry,
+                                               const std::string &curve) {
+  // curve() first: it rebuilds stale derived curves and bumps their version
+  const DiscountCurve &c = registry.curve(curve);
+  const std::uint64_t version = registry.version(curve);
+
+  // Registry versions start at 1, so a new entry (version 0) always misses
+  CachedAnnuities &entry = cache_[{registry.instance(), curve}];
+  if (entry.version == version) {
+    return entry.values;
+  }
+
+  entry.version = version;
+  entry.values.resize(size());
+  fixed_.price(c, 0, size(), entry.values, dfScratch_);
+  ++computations_;
+  return entry.values;
+}
+
+} // namespace quant
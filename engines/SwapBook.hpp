@@ -0,0 +1,69 @@
+#pragma once
+#include "../core/CashFlowBlock.hpp"
+#include "../core/CurveRegistry.hpp"
+#include "../core/DiscountCurve.hpp"
+#include "../instruments/Swap.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace quant {
+
+// Many swaps valued against shared curves in batched passes.
+//
+// Fixed legs are kept as annuity weights (notional * τ) in a CashFlowBlock,
+// so the annuities of the whole book are one batched discount-factor lookup
+// and a segmented dot product; floating legs need only the start and
+// maturity discount factors (single-curve). PV, par rate and annuity come
+// out of the same pass.
+//
+// Annuities against a registry curve are cached per (registry instance,
+// curve name, version): swaption pricing can call annuities() on every
+// request and only pays for the batch when the curve has actually been
+// replaced or rebuilt. Same-named curves in different registries never
+// share an entry.
+class SwapBook {
+public:
+  std::size_t add(const Swap &swap); // returns the swap's index
+  std::size_t size() const { return rates_.size(); }
+
+  // out must have size() elements
+  void value(const DiscountCurve &curve, QUANT_SPAN<SwapValuation> out);
+
+  // Cached annuities against registry curve `curve`, rebuilding stale
+  // curves in the registry if necessary. The reference is valid until the
+  // next call for the same registry and curve or the next add().
+  const std::vector<double> &annuities(CurveRegistry &registry,
+                                       const std::string &curve);
+
+  // Number of annuity batches computed by annuities(); hits are free
+  std::size_t annuityComputations() const { return computations_; }
+
+private:
+  struct CachedAnnuities {
+    std::uint64_t version = 0;
+    std::vector<double> values;
+  };
+
+  CashFlowBlock fixed_; // annuity weights per swap
+  std::vector<double> starts_;
+  std::vector<double> maturities_;
+  std::vector<double> notionals_;
+  std::vector<double> rates_;
+  std::vector<double> signs_;
+
+  // Keyed on (CurveRegistry::instance(), curve name)
+  std::map<std::pair<std::uint64_t, std::string>, CachedAnnuities> cache_;
+  std::size_t computations_ = 0;
+
+  // Scratch reused across calls
+  std::vector<double> annuities_;
+  std::vector<double> startDfs_;
+  std::vector<double> maturityDfs_;
+  std::vector<double> dfScratch_;
+};
+
+} // namespace quant
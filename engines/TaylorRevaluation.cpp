@@ -0,0 +1,414 @@
+#include "TaylorRevaluation.hpp"
+#include "../core/Parallel.hpp"
+#include "Black76.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace quant {
+
+namespace {
+
+// Relative bump for the third derivatives, taken by central differences of
+// the closed-form gamma and volga
+const double kThirdOrderBump = 1e-3;
+
+// Discounted second-order Black-76 Greeks. Put and call share everything
+// but delta.
+struct BlackGreeks {
+  double delta = 0.0;
+  double gamma = 0.0;
+  double vega = 0.0;
+  double vanna = 0.0;
+  double volga = 0.0;
+};
+
+BlackGreeks blackGreeks(double F, double K, double T, double sigma, double D,
+                        bool isCall) {
+  BlackGreeks g;
+  if (T <= 0.0 || sigma <= 0.0) {
+    // Intrinsic: piecewise linear in F, flat in σ
+    g.delta = isCall ? (F > K ? D : 0.0) : (F < K ? -D : 0.0);
+    return g;
+  }
+  const double sqrtT = std::sqrt(T);
+  const double stdDev = sigma * sqrtT;
+  const double d1 = (std::log(F / K) + 0.5 * stdDev * stdDev) / stdDev;
+  const double d2 = d1 - stdDev;
+  const double pdf = std::exp(-0.5 * d1 * d1) / std::sqrt(2.0 * kPi);
+  const double cdf = 0.5 * (1.0 + std::erf(d1 / std::sqrt(2.0)));
+
+  g.delta = D * (isCall ? cdf : cdf - 1.0);
+  g.gamma = D * pdf / (F * stdDev);
+  g.vega = D * F * pdf * sqrtT;
+  g.vanna = -D * pdf * d2 / sigma;
+  g.volga = g.vega * d1 * d2 / sigma;
+  return g;
+}
+
+// Hat-function weights of t on the node grid: t is interpolated from
+// nodes lo and hi (equal, with weight 1, outside the grid, matching
+// DiscountCurve's flat extrapolation)
+struct NodeWeights {
+  std::size_t lo, hi;
+  double wLo, wHi;
+};
+
+NodeWeights nodeWeights(double t, const std::vector<double> &nodes) {
+  const std::size_t last = nodes.size() - 1;
+  if (t <= nodes.front())
+    return {0, 0, 1.0, 0.0};
+  if (t >= nodes.back())
+    return {last, last, 1.0, 0.0};
+  const auto hi = static_cast<std::size_t>(
+      std::upper_bound(nodes.begin(), nodes.end(), t) - nodes.begin());
+  const double w = (t - nodes[hi - 1]) / (nodes[hi] - nodes[hi - 1]);
+  return {hi - 1, hi, 1.0 - w, w};
+}
+
+// One node of the bond expansion over n bonds. The node-major layout
+// gives each array unit stride; the outputs are restrict-qualified so the
+// loop vectorizes without a run-time overlap check per pair of arrays.
+// prevOff pairs with the previous node's shift, scaled by cross (0 at the
+// first node).
+void expandNode(std::size_t n, double x, const double *x0, const double *grad,
+                const double *diag, const double *prevOff, double cross,
+                double *__restrict value, double *__restrict maxShift,
+                double *__restrict prevShift) {
+  for (std::size_t i = 0; i < n; ++i) {
+    const double dx = x - x0[i];
+    value[i] += grad[i] * dx + 0.5 * dx * (diag[i] * dx +
+                                          2.0 * cross * prevOff[i] *
+                                              prevShift[i]);
+    maxShift[i] = std::max(maxShift[i], std::abs(dx));
+    prevShift[i] = dx;
+  }
+}
+
+// Per-tick inputs and anchored sensitivities of the options
+struct OptionView {
+  const double *forwardDf;
+  const double *vol;
+  const double *forward0;
+  const double *sigma0;
+  const double *df0;
+  const double *value0;
+  const double *delta;
+  const double *gamma;
+  const double *vega;
+  const double *vanna;
+  const double *volga;
+  const double *speed;
+  const double *zomma;
+  const double *vannaSigma;
+  const double *ultima;
+  const double *kink;
+  const double *quantity;
+  const double *expiryDf;
+};
+
+// Second-order expansion and third-order error bound of n options
+void expandOptions(const OptionView &o, std::size_t n,
+                   double *__restrict value, double *__restrict error) {
+  for (std::size_t i = 0; i < n; ++i) {
+    const double dF = 1.0 / o.forwardDf[i] - o.forward0[i];
+    const double dSigma = o.vol[i] - o.sigma0[i];
+    const double ratio = o.expiryDf[i] / o.df0[i];
+    const double taylor = o.value0[i] + o.delta[i] * dF +
+                          0.5 * o.gamma[i] * dF * dF + o.vega[i] * dSigma +
+                          0.5 * o.volga[i] * dSigma * dSigma +
+                          o.vanna[i] * dF * dSigma;
+    const double aF = std::abs(dF);
+    const double aS = std::abs(dSigma);
+    const double third = std::abs(o.speed[i]) * aF * aF * aF +
+                         3.0 * std::abs(o.zomma[i]) * aF * aF * aS +
+                         3.0 * std::abs(o.vannaSigma[i]) * aF * aS * aS +
+                         std::abs(o.ultima[i]) * aS * aS * aS;
+    value[i] = ratio * taylor;
+    error[i] = std::abs(o.quantity[i]) * ratio *
+               (third / 6.0 + o.kink[i] * std::abs(dF));
+  }
+}
+
+} // namespace
+
+TaylorRevaluation::TaylorRevaluation(Config config, std::size_t threads)
+    : config_(std::move(config)), threads_(threads),
+      nodes_(config_.keyRates.edges()), nodeLogDfs_(nodes_.size()) {
+  if (!(config_.positionErrorBudget >= 0.0) ||
+      !(config_.bookErrorBudget >= 0.0)) {
+    throw std::invalid_argument("Error budgets must be non-negative");
+  }
+  if (nodes_.empty()) {
+    throw std::invalid_argument("Need at least one key-rate node");
+  }
+}
+
+std::size_t TaylorRevaluation::addBond(const Bond &bond, double quantity) {
+  if (!(bond.maturity() > 0.0)) {
+    throw std::invalid_argument("Bond must have a positive maturity");
+  }
+  bonds_.bond.push_back(bond);
+  bonds_.quantity.push_back(quantity);
+  bonds_.maturity.push_back(bond.maturity());
+  const NodeWeights w = nodeWeights(bond.maturity(), nodes_);
+  bonds_.matLo.push_back(w.lo);
+  bonds_.matHi.push_back(w.hi);
+  bonds_.matWLo.push_back(w.wLo);
+  bonds_.matWHi.push_back(w.wHi);
+  anchored_ = false;
+  return bonds_.quantity.size() - 1;
+}
+
+std::size_t TaylorRevaluation::addOption(const EuropeanBondOption &option,
+                                         double quantity) {
+  options_.quantity.push_back(quantity);
+  options_.strike.push_back(option.strike());
+  options_.expiry.push_back(option.expiry());
+  options_.underlying.push_back(option.underlyingMaturity());
+  options_.isCall.push_back(
+      option.type() == EuropeanBondOption::Type::Call ? 1 : 0);
+  anchored_ = false;
+  return options_.quantity.size() - 1;
+}
+
+void TaylorRevaluation::nodeLogDfs(const DiscountCurve &curve) {
+  curve.df(nodes_, nodeLogDfs_);
+  for (double &x : nodeLogDfs_) {
+    x = -std::log(x);
+  }
+}
+
+// Expects nodeLogDfs_ to hold the node log discount factors of curve
+void TaylorRevaluation::anchorBond(std::size_t i, const DiscountCurve &curve) {
+  BondBlock &b = bonds_;
+  const std::size_t K = nodes_.size();
+  const std::size_t stride = b.quantity.size();
+  const double T = b.maturity[i];
+  b.logDf0[i] = -std::log(curve.df(T));
+
+  // Node k of this bond sits at k * stride
+  double *grad = &b.grad[i];
+  double *diag = &b.hessDiag[i];
+  double *off = &b.hessOff[i];
+  for (std::size_t k = 0; k < K; ++k) {
+    grad[k * stride] = 0.0;
+    diag[k * stride] = 0.0;
+    off[k * stride] = 0.0;
+    b.nodeLogDf0[k * stride + i] = nodeLogDfs_[k];
+  }
+
+  // P(x) = Σ CF P(t) exp(-Σ w_k(t) x_k)
+  double absPv = 0.0;
+  for (const CashFlow &cf : b.bond[i].cashFlows()) {
+    const double pv = cf.amount * curve.df(cf.time);
+    const NodeWeights w = nodeWeights(cf.time, nodes_);
+    const std::size_t lo = w.lo * stride;
+    const std::size_t hi = w.hi * stride;
+    grad[lo] -= w.wLo * pv;
+    grad[hi] -= w.wHi * pv;
+    diag[lo] += w.wLo * w.wLo * pv;
+    diag[hi] += w.wHi * w.wHi * pv;
+    off[lo] += w.wLo * w.wHi * pv;
+    absPv += std::abs(pv);
+  }
+  b.absPv[i] = absPv;
+  b.value0[i] = b.bond[i].price(curve);
+  b.value[i] = b.value0[i];
+  b.error[i] = 0.0;
+}
+
+void TaylorRevaluation::anchorOption(std::size_t i, double forward,
+                                     double sigma, double df) {
+  OptionBlock &o = options_;
+  const double K = o.strike[i];
+  const double T = o.expiry[i];
+  const bool call = o.isCall[i] != 0;
+
+  o.forward0[i] = forward;
+  o.sigma0[i] = sigma;
+  o.df0[i] = df;
+  o.value0[i] = Black76::price(forward, K, T, sigma, df, call);
+
+  const BlackGreeks g = blackGreeks(forward, K, T, sigma, df, call);
+  o.delta[i] = g.delta;
+  o.gamma[i] = g.gamma;
+  o.vega[i] = g.vega;
+  o.vanna[i] = g.vanna;
+  o.volga[i] = g.volga;
+
+  const bool live = T > 0.0 && sigma > 0.0;
+  o.kink[i] = live ? 0.0 : df;
+  if (live) {
+    const double hF = kThirdOrderBump * forward;
+    const double hS = kThirdOrderBump * sigma;
+    const BlackGreeks upF = blackGreeks(forward + hF, K, T, sigma, df, call);
+    const BlackGreeks downF = blackGreeks(forward - hF, K, T, sigma, df, call);
+    const BlackGreeks upS = blackGreeks(forward, K, T, sigma + hS, df, call);
+    const BlackGreeks downS = blackGreeks(forward, K, T, sigma - hS, df, call);
+    o.speed[i] = (upF.gamma - downF.gamma) / (2.0 * hF);
+    o.zomma[i] = (upS.gamma - downS.gamma) / (2.0 * hS);
+    o.vannaSigma[i] = (upS.vanna - downS.vanna) / (2.0 * hS);
+    o.ultima[i] = (upS.volga - downS.volga) / (2.0 * hS);
+  } else {
+    o.speed[i] = 0.0;
+    o.zomma[i] = 0.0;
+    o.vannaSigma[i] = 0.0;
+    o.ultima[i] = 0.0;
+  }
+  o.value[i] = o.value0[i];
+  o.error[i] = 0.0;
+}
+
+void TaylorRevaluation::fullRevalue(const DiscountCurve &curve,
+                                    QUANT_SPAN<const double> vols) {
+  const std::size_t nb = bondCount();
+  const std::size_t no = optionCount();
+  if (vols.size() != no) {
+    throw std::invalid_argument("Need one volatility per option");
+  }
+
+  BondBlock &b = bonds_;
+  for (auto *v : {&b.logDf0, &b.value0, &b.absPv, &b.value, &b.error}) {
+    v->resize(nb);
+  }
+  for (auto *v : {&b.nodeLogDf0, &b.grad, &b.hessDiag, &b.hessOff}) {
+    v->resize(nb * nodes_.size());
+  }
+  OptionBlock &o = options_;
+  for (auto *v : {&o.forward0, &o.sigma0, &o.df0, &o.value0, &o.delta,
+                  &o.gamma, &o.vega, &o.vanna, &o.volga, &o.speed, &o.zomma,
+                  &o.vannaSigma, &o.ultima, &o.kink, &o.value, &o.error}) {
+    v->resize(no);
+  }
+
+  nodeLogDfs(curve);
+  parallelFor(
+      nb, [&](std::size_t i) { anchorBond(i, curve); }, threads_);
+  parallelFor(
+      no,
+      [&](std::size_t i) {
+        anchorOption(i, curve.fwdBondPrice(o.underlying[i]), vols[i],
+                     curve.df(o.expiry[i]));
+      },
+      threads_);
+
+  reference_ = 0.0;
+  for (std::size_t i = 0; i < nb; ++i) {
+    reference_ += b.quantity[i] * b.value0[i];
+  }
+  for (std::size_t i = 0; i < no; ++i) {
+    reference_ += o.quantity[i] * o.value0[i];
+  }
+  ticks_ = 0;
+  anchored_ = true;
+}
+
+TaylorRevaluation::TickResult
+TaylorRevaluation::onTick(const DiscountCurve &curve,
+                          QUANT_SPAN<const double> vols) {
+  if (!anchored_) {
+    throw std::runtime_error(
+        "TaylorRevaluation: fullRevalue() must run before onTick()");
+  }
+  const std::size_t nb = bondCount();
+  const std::size_t no = optionCount();
+  if (vols.size() != no) {
+    throw std::invalid_argument("Need one volatility per option");
+  }
+  BondBlock &b = bonds_;
+  OptionBlock &o = options_;
+
+  // Market factors: one batched curve lookup per factor
+  b.dfs.resize(nb);
+  o.forwardDfs.resize(no);
+  o.expiryDfs.resize(no);
+  nodeLogDfs(curve);
+  curve.df(b.maturity, b.dfs);
+  curve.df(o.underlying, o.forwardDfs);
+  curve.df(o.expiry, o.expiryDfs);
+
+  // Second-order expansion, one node at a time over all bonds; value
+  // accumulates the expansion and error the largest node shift
+  const std::size_t K = nodes_.size();
+  std::copy(b.value0.begin(), b.value0.end(), b.value.begin());
+  std::fill(b.error.begin(), b.error.end(), 0.0);
+  b.shift.assign(nb, 0.0);
+  for (std::size_t k = 0; k < K; ++k) {
+    const std::size_t at = k * nb;
+    const std::size_t prev = k == 0 ? 0 : at - nb;
+    expandNode(nb, nodeLogDfs_[k], b.nodeLogDf0.data() + at,
+               b.grad.data() + at, b.hessDiag.data() + at,
+               b.hessOff.data() + prev, k == 0 ? 0.0 : 1.0, b.value.data(),
+               b.error.data(), b.shift.data());
+  }
+
+  // Third-order bound plus the actual shift at maturity against the node
+  // interpolation; the node lookups are gathers, so this pass stays scalar
+  for (std::size_t i = 0; i < nb; ++i) {
+    const std::size_t lo = b.matLo[i] * nb + i;
+    const std::size_t hi = b.matHi[i] * nb + i;
+    const double shift = -std::log(b.dfs[i]) - b.logDf0[i];
+    const double interpolated =
+        b.matWLo[i] * (nodeLogDfs_[b.matLo[i]] - b.nodeLogDf0[lo]) +
+        b.matWHi[i] * (nodeLogDfs_[b.matHi[i]] - b.nodeLogDf0[hi]);
+    const double maxShift = b.error[i];
+    // Every P(t) e^{-w.x} along the path is within e^{maxShift} of P(t)
+    const double cubed = maxShift * maxShift * maxShift;
+    b.error[i] = std::abs(b.quantity[i]) * b.absPv[i] *
+                 (cubed / 6.0 * std::exp(maxShift) +
+                  std::abs(shift - interpolated));
+  }
+
+  const OptionView view{o.forwardDfs.data(), vols.data(),
+                        o.forward0.data(),   o.sigma0.data(),
+                        o.df0.data(),        o.value0.data(),
+                        o.delta.data(),      o.gamma.data(),
+                        o.vega.data(),       o.vanna.data(),
+                        o.volga.data(),      o.speed.data(),
+                        o.zomma.data(),      o.vannaSigma.data(),
+                        o.ultima.data(),     o.kink.data(),
+                        o.quantity.data(),   o.expiryDfs.data()};
+  expandOptions(view, no, o.value.data(), o.error.data());
+
+  // Targeted exact repricing where the expansion is out of budget
+  TickResult result;
+  reprice_.clear();
+  for (std::size_t i = 0; i < nb; ++i) {
+    if (b.error[i] > config_.positionErrorBudget)
+      reprice_.push_back(i);
+  }
+  const std::size_t bondRepriced = reprice_.size();
+  for (std::size_t i = 0; i < no; ++i) {
+    if (o.error[i] > config_.positionErrorBudget)
+      reprice_.push_back(i);
+  }
+  parallelFor(
+      reprice_.size(),
+      [&](std::size_t k) {
+        const std::size_t i = reprice_[k];
+        if (k < bondRepriced) {
+          anchorBond(i, curve);
+        } else {
+          anchorOption(i, 1.0 / o.forwardDfs[i], vols[i], o.expiryDfs[i]);
+        }
+      },
+      threads_);
+  result.repriced = reprice_.size();
+
+  for (std::size_t i = 0; i < nb; ++i) {
+    result.value += b.quantity[i] * b.value[i];
+    result.errorEstimate += b.error[i];
+  }
+  for (std::size_t i = 0; i < no; ++i) {
+    result.value += o.quantity[i] * o.value[i];
+    result.errorEstimate += o.error[i];
+  }
+  result.pnl = result.value - reference_;
+  result.refreshRecommended = result.errorEstimate > config_.bookErrorBudget;
+  ++ticks_;
+  return result;
+}
+
+} // namespace quant
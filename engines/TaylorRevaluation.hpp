@@ -0,0 +1,138 @@
+#pragma once
+#include "../core/DiscountCurve.hpp"
+#include "../core/TenorBuckets.hpp"
+#include "../instruments/Bond.hpp"
+#include "../instruments/EuropeanBondOption.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace quant {
+
+// Tick-by-tick approximate revaluation of a bond and bond-option book.
+//
+// fullRevalue() prices every position exactly and caches its sensitivities
+// to the market factors it depends on:
+//   bonds:   key-rate shifts x_k = -Δ ln P(n_k) of the log discount factor
+//            at the Config::keyRates nodes n_k. The shift at a cash-flow
+//            date is the linear (hat-function) interpolation Σ w_k(t) x_k,
+//            flat beyond the end nodes, which is exact for log-linear
+//            curves whose pillars are nodes. ∂P/∂x_k = -Σ w_k CF P(t) and
+//            ∂²P/∂x_j∂x_k = Σ w_j w_k CF P(t) (tridiagonal, as only
+//            neighbouring hats overlap)
+//   options: forward F and volatility σ (delta, gamma, vega, vanna, volga);
+//            the expiry discount factor enters exactly as a ratio D1/D0
+// onTick() reads only those factors from the new market (one batched curve
+// lookup for the nodes, one per option factor) and applies the second-order
+// expansion in SoA loops with no per-position branching; the bond loop runs
+// node by node over all bonds and both loops vectorize. The cost per tick
+// is independent of the number of coupons.
+//
+// Each position also carries its third derivatives, so the truncation error
+// of a tick is estimated from the third-order term of the expansion, taken
+// in absolute value term by term. For bonds the Lagrange remainder gives a
+// bound, Σ |CF| P(t) e^m m³ / 6 with m = max|x_k|, and a model-error term
+// covers curve moves the nodes do not resolve: the bond's actual shift at
+// maturity is compared with its interpolation from the nodes and the gap
+// is charged against the bond's whole present value. For options the
+// term is evaluated at the anchor, which leads the remainder for the small
+// moves the budgets admit. Positions whose estimate exceeds the
+// per-position budget are repriced exactly and re-anchored at the tick's
+// market; when the remaining error across the book exceeds the book budget,
+// the result recommends a full refresh. Callers still run fullRevalue()
+// periodically (e.g. every few minutes).
+class TaylorRevaluation {
+public:
+  struct Config {
+    double positionErrorBudget; // currency units per position
+    double bookErrorBudget;     // currency units across the book
+    TenorBuckets keyRates;      // bond factor nodes: the bucket edges
+
+    Config()
+        : positionErrorBudget(0.01), bookErrorBudget(1.0),
+          keyRates({0.25, 0.5, 1, 2, 3, 5, 7, 10, 15, 20, 30}) {}
+  };
+
+  struct TickResult {
+    double value = 0.0;         // approximate book value
+    double pnl = 0.0;           // value - value at the last fullRevalue
+    double errorEstimate = 0.0; // remaining estimated truncation error
+    std::size_t repriced = 0;   // positions repriced exactly this tick
+    bool refreshRecommended = false;
+  };
+
+  explicit TaylorRevaluation(Config config = Config{},
+                             std::size_t threads = 0);
+
+  // Positions have no anchor until the next fullRevalue(); onTick() throws
+  // until then. Returns the index of the position within its kind.
+  std::size_t addBond(const Bond &bond, double quantity);
+  std::size_t addOption(const EuropeanBondOption &option, double quantity);
+
+  // Exact pricing and sensitivities for every position (in parallel).
+  // vols holds one Black-76 volatility per option, in addOption order.
+  void fullRevalue(const DiscountCurve &curve, QUANT_SPAN<const double> vols);
+
+  TickResult onTick(const DiscountCurve &curve, QUANT_SPAN<const double> vols);
+
+  double referenceValue() const { return reference_; }
+  std::size_t ticksSinceRefresh() const { return ticks_; }
+  std::size_t bondCount() const { return bonds_.quantity.size(); }
+  std::size_t optionCount() const { return options_.quantity.size(); }
+
+private:
+  // Per-position anchors and sensitivities in structure-of-arrays form.
+  // Per-node arrays are node-major: node k of bond i is at
+  // k * bondCount() + i.
+  struct BondBlock {
+    std::vector<Bond> bond;
+    std::vector<double> quantity;
+    std::vector<double> maturity;
+    std::vector<std::size_t> matLo, matHi; // nodes interpolating maturity
+    std::vector<double> matWLo, matWHi;
+    std::vector<double> logDf0;     // -ln P(maturity) at the anchor
+    std::vector<double> nodeLogDf0; // -ln P(n_k) at the anchor
+    std::vector<double> value0;
+    std::vector<double> grad;     // ∂P/∂x_k
+    std::vector<double> hessDiag; // ∂²P/∂x_k²
+    std::vector<double> hessOff;  // ∂²P/∂x_k∂x_{k+1}
+    std::vector<double> absPv;    // Σ |CF| P(t)
+    std::vector<double> value;    // latest tick
+    std::vector<double> error;    // latest tick
+    std::vector<double> dfs;      // scratch
+    std::vector<double> shift;    // scratch: previous node's shift
+  };
+
+  struct OptionBlock {
+    std::vector<double> quantity;
+    std::vector<double> strike;
+    std::vector<double> expiry;
+    std::vector<double> underlying; // underlying bond maturity
+    std::vector<std::uint8_t> isCall;
+    std::vector<double> forward0, sigma0, df0, value0;
+    std::vector<double> delta, gamma, vega, vanna, volga;
+    std::vector<double> speed, ultima; // ∂³V/∂F³, ∂³V/∂σ³
+    std::vector<double> zomma, vannaSigma; // ∂³V/∂F²∂σ, ∂³V/∂F∂σ²
+    std::vector<double> kink; // D0 for expired/zero-vol options, else 0
+    std::vector<double> value;
+    std::vector<double> error;
+    std::vector<double> forwardDfs, expiryDfs; // scratch
+  };
+
+  Config config_;
+  std::size_t threads_;
+  std::vector<double> nodes_;     // key-rate node times
+  std::vector<double> nodeLogDfs_; // scratch: -ln P(n_k) this tick
+  BondBlock bonds_;
+  OptionBlock options_;
+  double reference_ = 0.0;
+  std::size_t ticks_ = 0;
+  bool anchored_ = false;
+  std::vector<std::size_t> reprice_; // scratch
+
+  void nodeLogDfs(const DiscountCurve &curve);
+  void anchorBond(std::size_t i, const DiscountCurve &curve);
+  void anchorOption(std::size_t i, double forward, double sigma, double df);
+};
+
+} // namespace quant
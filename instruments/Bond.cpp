@@ -1,15 +1,25 @@
 #include "Bond.hpp"
+#include "../engines/Annuity.hpp"
 #include <cmath>
 
 namespace quant {
 
 Bond::Bond(double face, double cpnRate, int couponPerYear,
-           double maturityYears) {
+           double maturityYears)
+    : face_(face) {
   // Generate cash flows using bulletSchedule
   cfs_ = bulletSchedule(face, cpnRate, couponPerYear, maturityYears);
+  terms_ = bulletTerms(face, cpnRate, couponPerYear, maturityYears);
 }
 
 double Bond::price(const DiscountCurve &curve) const {
+  // On a flat curve a regular schedule discounts geometrically: O(1) pricing
+  if (terms_ && curve.isFlat()) {
+    if (auto closedForm = Annuity::price(*terms_, curve.df(terms_->period))) {
+      return *closedForm;
+    }
+  }
+
   double price = 0.0;
 
   for (const auto &cf : cfs_) {
@@ -20,6 +30,16 @@ double Bond::price(const DiscountCurve &curve) const {
   return price;
 }
 
+double Bond::price(const SpreadCurve &curve) const {
+  double price = 0.0;
+
+  for (const auto &cf : cfs_) {
+    price += cf.amount * curve.df(cf.time);
+  }
+
+  return price;
+}
+
 double Bond::yieldFromPrice(double cleanPrice, Compounding m,
                             const YieldSolver &solver) const {
   // Use the new solver interface
@@ -27,18 +47,37 @@ double Bond::yieldFromPrice(double cleanPrice, Compounding m,
 }
 
 double Bond::dv01(const DiscountCurve &curve, Compounding m) const {
+  // DV01 = -(∂P/∂y) * 0.0001
   double yield = extractYield(curve, m);
-  return Sensitivity::dv01(cfs_, yield, m);
+  return -yieldMoments(yield, m).delta * 0.0001;
 }
 
 double Bond::modDuration(const DiscountCurve &curve, Compounding m) const {
+  // Modified Duration = -(1/P) * (∂P/∂y)
   double yield = extractYield(curve, m);
-  return Sensitivity::modifiedDuration(cfs_, yield, m);
+  Sensitivity::Moments mo = yieldMoments(yield, m);
+  return mo.price == 0.0 ? 0.0 : -mo.delta / mo.price;
 }
 
 double Bond::convexity(const DiscountCurve &curve, Compounding m) const {
+  // Convexity = (1/P) * (∂²P/∂y²)
   double yield = extractYield(curve, m);
-  return Sensitivity::convexity(cfs_, yield, m);
+  Sensitivity::Moments mo = yieldMoments(yield, m);
+  return mo.price == 0.0 ? 0.0 : mo.gamma / mo.price;
+}
+
+Sensitivity::Moments Bond::yieldRisk(const DiscountCurve &curve,
+                                     Compounding m) const {
+  return yieldMoments(extractYield(curve, m), m);
+}
+
+Sensitivity::Moments Bond::yieldMoments(double yield, Compounding m) const {
+  if (terms_) {
+    if (auto closedForm = Annuity::moments(*terms_, yield, m)) {
+      return *closedForm;
+    }
+  }
+  return Sensitivity::moments(cfs_, yield, m);
 }
 
 double Bond::extractYield(const DiscountCurve &curve, Compounding m) const {
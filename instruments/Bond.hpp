@@ -1,8 +1,10 @@
 #pragma once
 #include "../core/CashFlow.hpp"
 #include "../core/DiscountCurve.hpp"
+#include "../core/SpreadCurve.hpp"
 #include "../engines/Sensitivity.hpp"
 #include "../engines/YieldSolver.hpp"
+#include <optional>
 #include <vector>
 
 // For bulletSchedule function
@@ -15,6 +17,7 @@ public:
   Bond(double face, double cpnRate, int couponPerYear, double maturityYears);
 
   double price(const DiscountCurve &curve) const;
+  double price(const SpreadCurve &curve) const; // issuer curve over a base
   double yieldFromPrice(double cleanPrice, Compounding m,
                         const YieldSolver &solver) const;
 
@@ -23,8 +26,25 @@ public:
   double modDuration(const DiscountCurve &curve, Compounding m) const;
   double convexity(const DiscountCurve &curve, Compounding m) const;
 
+  // Price, ∂P/∂y and ∂²P/∂y² at the curve-implied yield in one evaluation;
+  // dv01, modDuration and convexity are all derived from these
+  Sensitivity::Moments yieldRisk(const DiscountCurve &curve,
+                                 Compounding m) const;
+
+  const std::vector<CashFlow> &cashFlows() const { return cfs_; }
+  double face() const { return face_; }
+
+  // Time of the final cash flow (0 for an empty schedule)
+  double maturity() const { return cfs_.empty() ? 0.0 : cfs_.back().time; }
+
 private:
   std::vector<CashFlow> cfs_;
+  double face_;
+  std::optional<BulletTerms> terms_; // set when the schedule is regular
+
+  // Price and yield derivatives: closed form for regular schedules,
+  // Sensitivity's cash-flow loop otherwise
+  Sensitivity::Moments yieldMoments(double yield, Compounding m) const;
 
   // Helper to extract yield from discount curve (simplified assumption)
   double extractYield(const DiscountCurve &curve, Compounding m) const;
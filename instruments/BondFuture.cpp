@@ -0,0 +1,165 @@
+#include "BondFuture.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace quant {
+
+namespace {
+
+const double kFace = 100.0;
+
+// Coupon dates strictly after today, running back from maturity
+std::vector<CashFlow> deliverableSchedule(const Deliverable &d,
+                                          double &lastCouponBeforeToday) {
+  const double period = 1.0 / d.couponPerYear;
+  const double coupon = kFace * d.couponRate / d.couponPerYear;
+  const long future = static_cast<long>(std::ceil(d.maturity / period - 1e-9));
+
+  std::vector<CashFlow> flows;
+  flows.reserve(static_cast<std::size_t>(future));
+  for (long k = future - 1; k >= 0; --k) {
+    flows.push_back({d.maturity - k * period, coupon});
+  }
+  flows.back().amount += kFace;
+  lastCouponBeforeToday = d.maturity - future * period;
+  return flows;
+}
+
+} // namespace
+
+BondFuture::BondFuture(double deliveryTime, std::vector<Deliverable> basket,
+                       double notionalCoupon)
+    : delivery_(deliveryTime), basket_(std::move(basket)) {
+  if (!(deliveryTime > 0.0) || std::isinf(deliveryTime)) {
+    throw std::invalid_argument("Delivery time must be positive and finite");
+  }
+  if (basket_.empty()) {
+    throw std::invalid_argument("Deliverable basket must not be empty");
+  }
+  if (!(notionalCoupon > -1.0) || std::isinf(notionalCoupon)) {
+    throw std::invalid_argument("Invalid notional coupon");
+  }
+
+  const std::size_t n = basket_.size();
+  cf_.reserve(n);
+  accrued0_.reserve(n);
+  accruedT_.reserve(n);
+  income_.reserve(n);
+  incomeWeight_.reserve(n);
+
+  for (const Deliverable &d : basket_) {
+    if (d.couponPerYear <= 0 || !std::isfinite(d.couponRate)) {
+      throw std::invalid_argument("Invalid deliverable coupon terms");
+    }
+    if (!(d.maturity > deliveryTime) || std::isinf(d.maturity)) {
+      throw std::invalid_argument(
+          "Deliverable bonds must mature after the delivery date");
+    }
+    const double period = 1.0 / d.couponPerYear;
+    const double coupon = kFace * d.couponRate / d.couponPerYear;
+    double previous = 0.0;
+    std::vector<CashFlow> flows = deliverableSchedule(d, previous);
+
+    // Coupons before delivery; the last one sets accrual at delivery
+    double income = 0.0;
+    double weight = 0.0;
+    double previousAtDelivery = previous;
+    // Price at delivery on the notional yield, per coupon period
+    const double growth = 1.0 + notionalCoupon / d.couponPerYear;
+    double dirtyAtDelivery = 0.0;
+    for (const CashFlow &f : flows) {
+      if (f.time <= deliveryTime) {
+        income += f.amount;
+        weight += f.amount * (deliveryTime - f.time);
+        previousAtDelivery = f.time;
+      } else {
+        dirtyAtDelivery +=
+            f.amount *
+            std::pow(growth, -(f.time - deliveryTime) * d.couponPerYear);
+      }
+    }
+
+    const double accruedT =
+        coupon * (deliveryTime - previousAtDelivery) / period;
+    const double factor = (dirtyAtDelivery - accruedT) / kFace;
+    cf_.push_back(std::round(factor * 1e4) / 1e4);
+    accrued0_.push_back(coupon * (0.0 - previous) / period);
+    accruedT_.push_back(accruedT);
+    income_.push_back(income);
+    incomeWeight_.push_back(weight);
+    flows_.add(flows);
+  }
+}
+
+void BondFuture::checkPrices(QUANT_SPAN<const double> cleanPrices) const {
+  if (cleanPrices.size() != size()) {
+    throw std::invalid_argument("Need one clean price per deliverable");
+  }
+}
+
+void BondFuture::analyze(double futuresPrice,
+                         QUANT_SPAN<const double> cleanPrices,
+                         double repoRate, BasisAnalytics &out) const {
+  checkPrices(cleanPrices);
+  const std::size_t n = size();
+  out.invoice.resize(n);
+  out.grossBasis.resize(n);
+  out.netBasis.resize(n);
+  out.impliedRepo.resize(n);
+
+  const double T = delivery_;
+  for (std::size_t i = 0; i < n; ++i) {
+    const double dirty = cleanPrices[i] + accrued0_[i];
+    const double invoiceClean = futuresPrice * cf_[i];
+    const double forwardClean = dirty * (1.0 + repoRate * T) - income_[i] -
+                                repoRate * incomeWeight_[i] - accruedT_[i];
+    out.invoice[i] = invoiceClean + accruedT_[i];
+    out.grossBasis[i] = cleanPrices[i] - invoiceClean;
+    out.netBasis[i] = forwardClean - invoiceClean;
+    out.impliedRepo[i] = (out.invoice[i] + income_[i] - dirty) /
+                         (dirty * T - incomeWeight_[i]);
+  }
+
+  std::size_t best = 0;
+  for (std::size_t i = 1; i < n; ++i) {
+    if (out.impliedRepo[i] > out.impliedRepo[best])
+      best = i;
+  }
+  out.cheapest = best;
+}
+
+double BondFuture::fairPrice(QUANT_SPAN<const double> cleanPrices,
+                             double repoRate, std::size_t *ctd) const {
+  checkPrices(cleanPrices);
+  const double T = delivery_;
+  double best = 0.0;
+  std::size_t bestIndex = 0;
+  for (std::size_t i = 0; i < size(); ++i) {
+    const double dirty = cleanPrices[i] + accrued0_[i];
+    const double forwardClean = dirty * (1.0 + repoRate * T) - income_[i] -
+                                repoRate * incomeWeight_[i] - accruedT_[i];
+    const double price = forwardClean / cf_[i];
+    if (i == 0 || price < best) {
+      best = price;
+      bestIndex = i;
+    }
+  }
+  if (ctd)
+    *ctd = bestIndex;
+  return best;
+}
+
+void BondFuture::cleanPrices(const DiscountCurve &curve,
+                             QUANT_SPAN<double> out) const {
+  if (out.size() != size()) {
+    throw std::invalid_argument("Output size must match basket size");
+  }
+  std::vector<double> scratch;
+  flows_.price(curve, 0, size(), out, scratch);
+  for (std::size_t i = 0; i < size(); ++i) {
+    out[i] -= accrued0_[i];
+  }
+}
+
+} // namespace quant
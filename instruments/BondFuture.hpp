@@ -0,0 +1,81 @@
+#pragma once
+#include "../core/CashFlowBlock.hpp"
+#include "../core/DiscountCurve.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace quant {
+
+// Bond eligible for delivery, quoted per 100 face. Coupon dates run back
+// from maturity every 1/couponPerYear years, so a bond that is between
+// coupon dates today carries accrued interest.
+struct Deliverable {
+  double couponRate;
+  int couponPerYear;
+  double maturity; // years from today
+};
+
+// Per-bond basis analytics for one futures price, repo rate and set of
+// clean prices, all per 100 face
+struct BasisAnalytics {
+  std::vector<double> invoice;     // F * CF + accrued at delivery
+  std::vector<double> grossBasis;  // P - F * CF
+  std::vector<double> netBasis;    // forward clean price - F * CF
+  std::vector<double> impliedRepo; // simple rate earned by cash-and-carry
+  std::size_t cheapest = 0;        // highest implied repo
+};
+
+// Bond futures contract with a fixed deliverable basket.
+//
+// Everything that does not depend on the market is computed once at
+// construction: conversion factors (clean price per unit face at the
+// contract's notional coupon yield on the delivery date, rounded to four
+// decimals as exchanges publish them), accrued interest today and at
+// delivery, and the coupons received before delivery. A tick is then one
+// branch-free pass over the basket's arrays. With D0 = P + AI0 and coupons
+// C paid at t_c <= T:
+//   forward dirty = D0 (1 + r T) - Σ C (1 + r (T - t_c))
+//   implied repo  = (F CF + AI_T + Σ C - D0) / (D0 T - Σ C (T - t_c))
+// (simple interest, money-market convention in year fractions).
+class BondFuture {
+public:
+  static constexpr double kNotionalCoupon = 0.06;
+
+  BondFuture(double deliveryTime, std::vector<Deliverable> basket,
+             double notionalCoupon = kNotionalCoupon);
+
+  std::size_t size() const { return basket_.size(); }
+  double deliveryTime() const { return delivery_; }
+  const std::vector<Deliverable> &basket() const { return basket_; }
+  const std::vector<double> &conversionFactors() const { return cf_; }
+  const std::vector<double> &accruedToday() const { return accrued0_; }
+  const std::vector<double> &accruedAtDelivery() const { return accruedT_; }
+
+  // Gross/net basis and implied repo of every deliverable in one pass
+  void analyze(double futuresPrice, QUANT_SPAN<const double> cleanPrices,
+               double repoRate, BasisAnalytics &out) const;
+
+  // Fast mode without delivery options: the fair futures price is the
+  // cheapest forward clean price per unit conversion factor, min_i
+  // fwd_i / CF_i, computed in the same single pass. ctd (if given)
+  // receives the index of the bond attaining the minimum.
+  double fairPrice(QUANT_SPAN<const double> cleanPrices, double repoRate,
+                   std::size_t *ctd = nullptr) const;
+
+  // Clean prices of the basket implied by a curve (batched lookup)
+  void cleanPrices(const DiscountCurve &curve, QUANT_SPAN<double> out) const;
+
+private:
+  double delivery_;
+  std::vector<Deliverable> basket_;
+  std::vector<double> cf_;
+  std::vector<double> accrued0_;
+  std::vector<double> accruedT_;
+  std::vector<double> income_;       // Σ C paid in (0, T]
+  std::vector<double> incomeWeight_; // Σ C (T - t_c)
+  CashFlowBlock flows_;              // full schedules for cleanPrices()
+
+  void checkPrices(QUANT_SPAN<const double> cleanPrices) const;
+};
+
+} // namespace quant
@@ -0,0 +1,64 @@
+#include "CapFloor.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace quant {
+
+CapFloor::CapFloor(Type type, double notional, double strike, double maturity,
+                   int frequency, double start)
+    : type_(type), notional_(notional), strike_(strike), accrual_(0.0) {
+  if (!(notional > 0.0) || std::isinf(notional)) {
+    throw std::invalid_argument("Cap notional must be positive and finite");
+  }
+  if (!std::isfinite(strike)) {
+    throw std::invalid_argument("Cap strike must be finite");
+  }
+  if (frequency <= 0) {
+    throw std::invalid_argument("Cap frequency must be positive");
+  }
+  if (!(start >= 0.0) || !(maturity > start) || std::isinf(maturity)) {
+    throw std::invalid_argument("Cap requires 0 <= start < maturity");
+  }
+  const double span = (maturity - start) * frequency;
+  const long periods = std::lround(span);
+  if (periods < 1 || std::abs(periods - span) > 1e-9) {
+    throw std::invalid_argument(
+        "Cap tenor must be a whole number of periods: " +
+        std::to_string(maturity - start));
+  }
+
+  accrual_ = 1.0 / frequency;
+  fixings_.reserve(static_cast<std::size_t>(periods));
+  payments_.reserve(static_cast<std::size_t>(periods));
+  for (long j = 1; j <= periods; ++j) {
+    fixings_.push_back(start + (j - 1) * accrual_);
+    payments_.push_back(j == periods ? maturity : start + j * accrual_);
+  }
+}
+
+double CapFloor::price(const DiscountCurve &curve, double vol,
+                       VolatilityType volType, Precision precision) const {
+  const std::size_t n = caplets();
+  std::vector<double> fixingDfs(n), paymentDfs(n), values(n);
+  curve.df(fixings_, fixingDfs, precision);
+  curve.df(payments_, paymentDfs, precision);
+
+  Black76Batch batch;
+  batch.reserve(n);
+  const bool isCall = type_ == Type::Cap;
+  for (std::size_t j = 0; j < n; ++j) {
+    double forward = (fixingDfs[j] / paymentDfs[j] - 1.0) / accrual_;
+    batch.push_back(forward, strike_, fixings_[j], vol, paymentDfs[j],
+                    isCall);
+  }
+  priceOptionBatch(volType, batch, values, precision);
+
+  double sum = 0.0;
+  for (double v : values) {
+    sum += v;
+  }
+  return notional_ * accrual_ * sum;
+}
+
+} // namespace quant
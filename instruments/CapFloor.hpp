@@ -0,0 +1,48 @@
+#pragma once
+#include "../core/DiscountCurve.hpp"
+#include "../engines/Bachelier.hpp"
+#include <vector>
+
+namespace quant {
+
+// Interest rate cap or floor: a strip of caplets (floorlets) on the simple
+// forward rate of each 1/frequency accrual period from start to maturity.
+//
+// Caplet j fixes at t_{j-1}, pays at t_j and is worth
+//   N τ P(t_j) Black(F_j, K, t_{j-1}, σ)
+// on the forward F_j = (P(t_{j-1}) / P(t_j) - 1) / τ,
+// with Black-76 or Bachelier depending on the volatility type. The first
+// caplet is included; with start = 0 its rate is already fixed and it is
+// worth its discounted intrinsic value.
+class CapFloor {
+public:
+  enum class Type { Cap, Floor };
+
+  CapFloor(Type type, double notional, double strike, double maturity,
+           int frequency = 4, double start = 0.0);
+
+  // All caplets are priced in one batch kernel call
+  double price(const DiscountCurve &curve, double vol,
+               VolatilityType volType = VolatilityType::Lognormal,
+               Precision precision = kDefaultPrecision) const;
+
+  Type type() const { return type_; }
+  double notional() const { return notional_; }
+  double strike() const { return strike_; }
+  double accrual() const { return accrual_; }
+  std::size_t caplets() const { return payments_.size(); }
+
+  // Fixing time of each caplet (t_{j-1}) and its payment time (t_j)
+  const std::vector<double> &fixingTimes() const { return fixings_; }
+  const std::vector<double> &paymentTimes() const { return payments_; }
+
+private:
+  Type type_;
+  double notional_;
+  double strike_;
+  double accrual_; // τ = 1 / frequency
+  std::vector<double> fixings_;
+  std::vector<double> payments_;
+};
+
+} // namespace quant
@@ -49,8 +49,7 @@ double EuropeanBondOption::vegaBlack(const DiscountCurve &curve,
 double EuropeanBondOption::getForwardPrice(const DiscountCurve &curve) const {
   // Underlying forward price = curve.fwdBondPrice(T_ + maturity-of-bond)
   // For demo, bond maturity is T + 5 years
-  double bondMaturity = T_ + 5.0;
-  return curve.fwdBondPrice(bondMaturity);
+  return curve.fwdBondPrice(underlyingMaturity());
 }
 
 } // namespace quant
\ No newline at end of file
@@ -16,6 +16,12 @@ public:
                  std::size_t paths = 100'000) const;
   double vegaBlack(const DiscountCurve &curve, double sigma) const;
 
+  Type type() const { return type_; }
+  double strike() const { return K_; }
+  double expiry() const { return T_; }
+  // Maturity of the underlying bond (5 years after option expiry)
+  double underlyingMaturity() const { return T_ + 5.0; }
+
 private:
   Type type_;
   double K_; // Strike price
@@ -0,0 +1,90 @@
+#include "MortgagePool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace quant {
+
+namespace {
+
+const double kPsaBaseCpr = 0.06;
+const int kPsaRampMonths = 30;
+
+} // namespace
+
+void validatePool(const MortgagePool &pool) {
+  if (!(pool.balance > 0.0) || std::isinf(pool.balance)) {
+    throw std::invalid_argument("Pool balance must be positive and finite");
+  }
+  if (pool.termMonths <= 0) {
+    throw std::invalid_argument("Pool remaining term must be positive");
+  }
+  if (pool.ageMonths < 0) {
+    throw std::invalid_argument("Pool age must not be negative");
+  }
+  if (!(pool.grossCoupon >= 0.0) || std::isinf(pool.grossCoupon)) {
+    throw std::invalid_argument("Pool gross coupon must be non-negative");
+  }
+  if (!(pool.netCoupon >= 0.0) || pool.netCoupon > pool.grossCoupon) {
+    throw std::invalid_argument(
+        "Pool net coupon must be between zero and the gross coupon");
+  }
+}
+
+void scheduledBalances(const MortgagePool &pool, QUANT_SPAN<double> out) {
+  validatePool(pool);
+  const int n = pool.termMonths;
+  if (out.size() != static_cast<std::size_t>(n) + 1) {
+    throw std::invalid_argument("Output size must be termMonths + 1");
+  }
+
+  const double r = pool.grossCoupon / 12.0;
+  if (r == 0.0) {
+    for (int k = 0; k <= n; ++k) {
+      out[k] = 1.0 - static_cast<double>(k) / n;
+    }
+  } else {
+    // (1+r)^k = exp(k ln(1+r)), denominators via expm1 for small rates
+    const double lg = std::log1p(r);
+    const double growthN = std::expm1(n * lg);
+    for (int k = 0; k <= n; ++k) {
+      out[k] = (growthN - std::expm1(k * lg)) / growthN;
+    }
+  }
+  out[0] = 1.0;
+  out[n] = 0.0;
+}
+
+PrepaymentModel PrepaymentModel::constantCpr(double cpr) {
+  if (!(cpr >= 0.0 && cpr <= 1.0)) {
+    throw std::invalid_argument("CPR must be in [0, 1]");
+  }
+  return PrepaymentModel(Type::Cpr, cpr);
+}
+
+PrepaymentModel PrepaymentModel::psa(double speed) {
+  if (!(speed >= 0.0) || std::isinf(speed)) {
+    throw std::invalid_argument("PSA speed must be non-negative and finite");
+  }
+  return PrepaymentModel(Type::Psa, speed);
+}
+
+double PrepaymentModel::annualRate(int ageMonths) const {
+  if (type_ == Type::Cpr) {
+    return speed_;
+  }
+  const int ramp = std::clamp(ageMonths, 0, kPsaRampMonths);
+  const double cpr = kPsaBaseCpr * (speed_ / 100.0) * ramp / kPsaRampMonths;
+  return std::min(cpr, 1.0);
+}
+
+double PrepaymentModel::smm(int ageMonths) const {
+  // 1 - (1 - CPR)^(1/12) without cancellation at low speeds
+  const double cpr = annualRate(ageMonths);
+  if (cpr >= 1.0) {
+    return 1.0;
+  }
+  return -std::expm1(std::log1p(-cpr) / 12.0);
+}
+
+} // namespace quant
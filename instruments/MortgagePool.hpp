@@ -0,0 +1,54 @@
+#pragma once
+#include "../core/DiscountCurve.hpp"
+#include <vector>
+
+namespace quant {
+
+// Pass-through pool of level-payment fixed-rate mortgages, summarised by
+// its weighted-average terms. Payments are monthly; month m of a
+// projection is paid at t = m / 12 years.
+struct MortgagePool {
+  double balance;     // current outstanding principal
+  double grossCoupon; // WAC: annual rate paid by borrowers
+  double netCoupon;   // pass-through rate paid to investors
+  int termMonths;     // WAM: remaining payments
+  int ageMonths = 0;  // WALA: payments already made
+};
+
+// Throws std::invalid_argument for a non-positive balance or term, negative
+// age or coupons, or a net coupon above the gross coupon
+void validatePool(const MortgagePool &pool);
+
+// Scheduled balance as a fraction of today's balance after each of the next
+// termMonths payments when nobody prepays: out[0] = 1, out[term] = 0 and
+//   out[k] = ((1+r)^n - (1+r)^k) / ((1+r)^n - 1),  r = WAC/12, n = term
+// (straight-line when WAC is zero). out must have termMonths + 1 elements.
+void scheduledBalances(const MortgagePool &pool, QUANT_SPAN<double> out);
+
+// Prepayment speed as a function of loan age in months.
+//   Cpr: constant conditional prepayment rate (annual)
+//   Psa: the PSA ramp scaled by speed/100, i.e. CPR = 6% * min(age, 30) / 30
+//        at 100 PSA, capped at 100%
+// The monthly rate applied to the post-amortization balance is the single
+// monthly mortality SMM = 1 - (1 - CPR)^(1/12).
+class PrepaymentModel {
+public:
+  enum class Type { Cpr, Psa };
+
+  static PrepaymentModel constantCpr(double cpr);
+  static PrepaymentModel psa(double speed);
+
+  Type type() const { return type_; }
+  double speed() const { return speed_; }
+
+  double annualRate(int ageMonths) const;
+  double smm(int ageMonths) const;
+
+private:
+  PrepaymentModel(Type type, double speed) : type_(type), speed_(speed) {}
+
+  Type type_;
+  double speed_; // CPR for Cpr, PSA speed (100 = standard) for Psa
+};
+
+} // namespace quant
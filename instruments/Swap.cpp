@@ -0,0 +1,94 @@
+#include "Swap.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace quant {
+
+namespace {
+
+// Number of whole periods of 1/frequency in [start, maturity]
+long periodCount(double start, double maturity, int frequency) {
+  if (frequency <= 0) {
+    throw std::invalid_argument("Swap payment frequency must be positive");
+  }
+  const double span = (maturity - start) * frequency;
+  const long periods = std::lround(span);
+  if (periods < 1 || std::abs(periods - span) > 1e-9) {
+    throw std::invalid_argument(
+        "Swap tenor must be a whole number of payment periods: " +
+        std::to_string(maturity - start));
+  }
+  return periods;
+}
+
+} // namespace
+
+Swap::Swap(Type type, double notional, double fixedRate, double maturity,
+           int fixedFrequency, int floatFrequency, double start)
+    : type_(type), notional_(notional), fixedRate_(fixedRate), start_(start),
+      maturity_(maturity), fixedFrequency_(fixedFrequency),
+      floatFrequency_(floatFrequency) {
+  if (!(notional > 0.0) || std::isinf(notional)) {
+    throw std::invalid_argument("Swap notional must be positive and finite");
+  }
+  if (!std::isfinite(fixedRate)) {
+    throw std::invalid_argument("Swap fixed rate must be finite");
+  }
+  if (!(start >= 0.0) || !(maturity > start) || std::isinf(maturity)) {
+    throw std::invalid_argument("Swap requires 0 <= start < maturity");
+  }
+  periodCount(start, maturity, floatFrequency);
+
+  const long payments = periodCount(start, maturity, fixedFrequency);
+  const double tau = 1.0 / fixedFrequency;
+  fixed_.reserve(static_cast<std::size_t>(payments));
+  for (long j = 1; j <= payments; ++j) {
+    double t = (j == payments) ? maturity : start + j * tau;
+    fixed_.push_back({t, notional * tau});
+  }
+}
+
+SwapValuation Swap::finish(double annuity, double floatLeg) const {
+  SwapValuation v;
+  v.annuity = annuity;
+  v.floatLeg = floatLeg;
+  v.fixedLeg = fixedRate_ * annuity;
+  v.parRate = annuity != 0.0 ? floatLeg / annuity : 0.0;
+  v.pv = sign() * (floatLeg - v.fixedLeg);
+  return v;
+}
+
+SwapValuation Swap::value(const DiscountCurve &curve) const {
+  double annuity = 0.0;
+  for (const CashFlow &cf : fixed_) {
+    annuity += cf.amount * curve.df(cf.time);
+  }
+  // Single curve: Σ τ F_j P(t_j) = P(start) - P(maturity)
+  const double floatLeg =
+      notional_ * (curve.df(start_) - curve.df(maturity_));
+  return finish(annuity, floatLeg);
+}
+
+SwapValuation Swap::value(const DiscountCurve &discount,
+                          const DiscountCurve &projection) const {
+  double annuity = 0.0;
+  for (const CashFlow &cf : fixed_) {
+    annuity += cf.amount * discount.df(cf.time);
+  }
+
+  // N τ F_j = N (P_proj(t_{j-1}) / P_proj(t_j) - 1), discounted at t_j
+  const long periods = std::lround((maturity_ - start_) * floatFrequency_);
+  const double tau = 1.0 / floatFrequency_;
+  double floatLeg = 0.0;
+  double prevProj = projection.df(start_);
+  for (long j = 1; j <= periods; ++j) {
+    double t = (j == periods) ? maturity_ : start_ + j * tau;
+    double proj = projection.df(t);
+    floatLeg += (prevProj / proj - 1.0) * discount.df(t);
+    prevProj = proj;
+  }
+  return finish(annuity, notional_ * floatLeg);
+}
+
+} // namespace quant
@@ -0,0 +1,65 @@
+#pragma once
+#include "../core/CashFlow.hpp"
+#include "../core/DiscountCurve.hpp"
+#include <vector>
+
+namespace quant {
+
+// Everything a swap valuation produces, from one pass over the schedule
+struct SwapValuation {
+  double pv = 0.0;       // to the holder: floatLeg - fixedLeg for a payer
+  double fixedLeg = 0.0; // fixedRate * annuity
+  double floatLeg = 0.0;
+  double annuity = 0.0;  // notional * Σ τ P(t): PV of one unit of fixed rate
+  double parRate = 0.0;  // floatLeg / annuity
+};
+
+// Vanilla fixed-for-floating interest rate swap on a regular schedule.
+//
+// Fixed coupons are paid every 1/fixedFrequency years and floating coupons
+// every 1/floatFrequency years from start to maturity. Against a single
+// curve the floating leg telescopes to notional * (P(start) - P(maturity)),
+// so value() needs one discount factor per fixed date plus two. With a
+// separate projection curve each floating coupon is projected as the simple
+// forward rate over its accrual period and discounted on the discount curve.
+class Swap {
+public:
+  enum class Type { Payer, Receiver }; // pay or receive the fixed leg
+
+  Swap(Type type, double notional, double fixedRate, double maturity,
+       int fixedFrequency = 1, int floatFrequency = 4, double start = 0.0);
+
+  SwapValuation value(const DiscountCurve &curve) const;
+  SwapValuation value(const DiscountCurve &discount,
+                      const DiscountCurve &projection) const;
+
+  double price(const DiscountCurve &curve) const { return value(curve).pv; }
+
+  // Fixed-leg annuity weights as cash flows: (payment time, notional * τ)
+  const std::vector<CashFlow> &annuityFlows() const { return fixed_; }
+
+  Type type() const { return type_; }
+  double notional() const { return notional_; }
+  double fixedRate() const { return fixedRate_; }
+  double start() const { return start_; }
+  double maturity() const { return maturity_; }
+  int fixedFrequency() const { return fixedFrequency_; }
+  int floatFrequency() const { return floatFrequency_; }
+
+  // +1 for a payer, -1 for a receiver: pv = sign * (floatLeg - fixedLeg)
+  double sign() const { return type_ == Type::Payer ? 1.0 : -1.0; }
+
+private:
+  Type type_;
+  double notional_;
+  double fixedRate_;
+  double start_;
+  double maturity_;
+  int fixedFrequency_;
+  int floatFrequency_;
+  std::vector<CashFlow> fixed_;
+
+  SwapValuation finish(double annuity, double floatLeg) const;
+};
+
+} // namespace quant
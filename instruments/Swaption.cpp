@@ -0,0 +1,31 @@
+#include "Swaption.hpp"
+#include <stdexcept>
+#include <utility>
+
+namespace quant {
+
+Swaption::Swaption(Swap underlying, double expiry)
+    : swap_(std::move(underlying)), expiry_(expiry) {
+  if (!(expiry >= 0.0) || expiry > swap_.start()) {
+    throw std::invalid_argument(
+        "Swaption expiry must lie in [0, underlying start]");
+  }
+}
+
+double Swaption::price(const DiscountCurve &curve, double vol,
+                       VolatilityType volType) const {
+  SwapValuation v = swap_.value(curve);
+  return price(v.annuity, v.parRate, vol, volType);
+}
+
+double Swaption::price(double annuity, double forwardRate, double vol,
+                       VolatilityType volType) const {
+  if (volType == VolatilityType::Normal) {
+    return Bachelier::price(forwardRate, swap_.fixedRate(), expiry_, vol,
+                            annuity, isPayer());
+  }
+  return Black76::price(forwardRate, swap_.fixedRate(), expiry_, vol, annuity,
+                        isPayer());
+}
+
+} // namespace quant
@@ -0,0 +1,37 @@
+#pragma once
+#include "../core/DiscountCurve.hpp"
+#include "../engines/Bachelier.hpp"
+#include "Swap.hpp"
+
+namespace quant {
+
+// European swaption: the right at expiry to enter the underlying swap.
+//
+// A payer swaption (underlying pays fixed) is a call on the forward swap
+// rate, a receiver swaption a put, both struck at the swap's fixed rate and
+// scaled by the forward annuity:
+//   V = A * Black(S, K, T_expiry, σ) with A = annuity, S = par rate
+// so pricing is one fused swap valuation plus one kernel evaluation.
+class Swaption {
+public:
+  // The underlying swap must start on or after expiry
+  Swaption(Swap underlying, double expiry);
+
+  double price(const DiscountCurve &curve, double vol,
+               VolatilityType volType = VolatilityType::Lognormal) const;
+
+  // Price from an already known annuity and forward swap rate, e.g. from
+  // SwapBook's per-curve-version annuity cache
+  double price(double annuity, double forwardRate, double vol,
+               VolatilityType volType = VolatilityType::Lognormal) const;
+
+  const Swap &underlying() const { return swap_; }
+  double expiry() const { return expiry_; }
+  bool isPayer() const { return swap_.type() == Swap::Type::Payer; }
+
+private:
+  Swap swap_;
+  double expiry_;
+};
+
+} // namespace quant
@@ -274,4 +274,49 @@ TEST_CASE("Bond Price Sensitivity Tests", "[bond][sensitivity]") {
 
     REQUIRE(dv01 == Approx(expectedDV01).margin(1e-6));
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Closed-form pricing of regular bullet bonds", "[bond][annuity]") {
+  SECTION("Regular schedules are detected") {
+    REQUIRE(bulletTerms(100.0, 0.05, 2, 30.0).has_value());
+    REQUIRE(bulletTerms(100.0, 0.05, 2, 30.0)->periods == 60);
+    REQUIRE_FALSE(bulletTerms(100.0, 0.05, 2, 2.3).has_value());
+  }
+
+  SECTION("Price, duration and convexity match the cash-flow loop") {
+    for (int freq : {1, 2, 4, 12}) {
+      for (double maturity : {2.0, 10.0, 30.0}) {
+        for (double y : {-0.01, 0.003, 0.02, 0.05, 0.12}) {
+          for (auto m : {Compounding::Annual, Compounding::Semi,
+                         Compounding::Monthly, Compounding::Continuous}) {
+            Bond bond(100.0, 0.045, freq, maturity);
+            auto cfs = bulletSchedule(100.0, 0.045, freq, maturity);
+            DiscountCurve curve(y, m, DayCount::ACT_365F);
+
+            double loopPrice = 0.0;
+            for (const auto &cf : cfs) {
+              loopPrice += cf.amount * curve.df(cf.time);
+            }
+
+            INFO("freq " << freq << " maturity " << maturity << " y " << y
+                         << " m " << static_cast<int>(m));
+            REQUIRE(bond.price(curve) == Approx(loopPrice).epsilon(1e-12));
+            REQUIRE(bond.modDuration(curve, m) ==
+                    Approx(Sensitivity::modifiedDuration(cfs, y, m))
+                        .epsilon(1e-10));
+            REQUIRE(bond.convexity(curve, m) ==
+                    Approx(Sensitivity::convexity(cfs, y, m)).epsilon(1e-9));
+          }
+        }
+      }
+    }
+  }
+
+  SECTION("Irregular maturities fall back to the loop") {
+    Bond bond(100.0, 0.05, 2, 2.3);
+    DiscountCurve curve(0.04, Compounding::Semi, DayCount::ACT_365F);
+    auto cfs = bulletSchedule(100.0, 0.05, 2, 2.3);
+    REQUIRE(bond.price(curve) ==
+            Approx(Sensitivity::price(cfs, 0.04, Compounding::Semi)));
+  }
+}
@@ -3,9 +3,15 @@
 
 #include "../core/CashFlow.hpp"
 #include "../core/DiscountCurve.hpp"
+#include "../engines/PoolCashFlowEngine.hpp"
 #include "../engines/Sensitivity.hpp"
 #include "../engines/YieldSolver.hpp"
 #include "../instruments/Bond.hpp"
+#include "../instruments/BondFuture.hpp"
+#include "../instruments/MortgagePool.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <vector>
 
 using namespace quant;
 using Catch::Approx;
@@ -195,4 +201,228 @@ TEST_CASE("Bond analytics integration", "[bond][analytics]") {
     double expected_dv01 = price * modDur * 0.0001;
     REQUIRE(dv01 == Approx(expected_dv01).margin(0.001));
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Flat-yield kernels match the pow formulas", "[sensitivity]") {
+  const double y = 0.047;
+
+  SECTION("Regular schedule uses the geometric recurrence") {
+    auto cashFlows = bulletSchedule(100.0, 0.05, 12, 30.0); // 360 flows
+    for (auto comp : {Compounding::Annual, Compounding::Semi,
+                      Compounding::Monthly, Compounding::Continuous}) {
+      double P = 0.0, dP = 0.0, d2P = 0.0;
+      for (const auto &cf : cashFlows) {
+        if (comp == Compounding::Continuous) {
+          double df = std::exp(-y * cf.time);
+          P += cf.amount * df;
+          dP -= cf.amount * cf.time * df;
+          d2P += cf.amount * cf.time * cf.time * df;
+        } else {
+          double m = static_cast<double>(comp);
+          double base = 1.0 + y / m;
+          P += cf.amount * std::pow(base, -m * cf.time);
+          dP -= cf.amount * cf.time * std::pow(base, -m * cf.time - 1.0);
+          d2P += cf.amount * (cf.time * cf.time + cf.time / m) *
+                 std::pow(base, -m * cf.time - 2.0);
+        }
+      }
+
+      REQUIRE(Sensitivity::price(cashFlows, y, comp) ==
+              Approx(P).epsilon(1e-13));
+      REQUIRE(Sensitivity::priceDelta(cashFlows, y, comp) ==
+              Approx(dP).epsilon(1e-13));
+      REQUIRE(Sensitivity::priceGamma(cashFlows, y, comp) ==
+              Approx(d2P).epsilon(1e-13));
+    }
+  }
+
+  SECTION("Batched discount factors") {
+    std::vector<double> regular, irregular;
+    for (int i = 1; i <= 200; ++i) {
+      regular.push_back(0.25 * i);
+      irregular.push_back(0.1 * i + 0.001 * (i % 7));
+    }
+    std::vector<double> out(regular.size());
+
+    Sensitivity::discountFactors(regular, y, Compounding::Semi, out);
+    for (std::size_t i = 0; i < regular.size(); ++i) {
+      REQUIRE(out[i] ==
+              Approx(std::pow(1.0 + y / 2.0, -2.0 * regular[i])).epsilon(1e-13));
+    }
+
+    Sensitivity::discountFactors(irregular, y, Compounding::Quarterly, out);
+    for (std::size_t i = 0; i < irregular.size(); ++i) {
+      REQUIRE(out[i] == Approx(std::pow(1.0 + y / 4.0, -4.0 * irregular[i]))
+                            .epsilon(1e-13));
+    }
+  }
+}
+
+TEST_CASE("Bond futures basis analytics", "[bond][futures]") {
+  std::vector<Deliverable> basket = {{0.06, 2, 10.25},
+                                     {0.045, 2, 8.8},
+                                     {0.075, 2, 12.0},
+                                     {0.05, 1, 9.6}};
+  BondFuture future(0.25, basket);
+
+  SECTION("Conversion factors and accrued interest") {
+    // A notional-coupon bond on the coupon grid converts at par
+    BondFuture par(0.5, {{0.06, 2, 10.5}});
+    REQUIRE(par.conversionFactors()[0] == Approx(1.0));
+
+    REQUIRE(future.conversionFactors()[2] > 1.0); // above-notional coupon
+    REQUIRE(future.conversionFactors()[1] < 1.0);
+    // 8.8y semi-annual: last coupon 0.2y ago, next one after delivery
+    REQUIRE(future.accruedToday()[1] == Approx(2.25 * 0.2 / 0.5));
+    REQUIRE(future.accruedAtDelivery()[1] == Approx(2.25 * 0.45 / 0.5));
+    // 9.6y annual: coupon paid at 0.6y, after delivery as well
+    REQUIRE(future.accruedToday()[3] == Approx(5.0 * 0.4));
+
+    REQUIRE_THROWS_AS(BondFuture(1.0, {{0.05, 2, 0.75}}),
+                      std::invalid_argument);
+  }
+
+  SECTION("Implied repo, net basis and cheapest to deliver") {
+    DiscountCurve curve(0.04, Compounding::Annual, DayCount::ACT_365F);
+    std::vector<double> clean(future.size());
+    future.cleanPrices(curve, clean);
+
+    const double repo = 0.035;
+    std::size_t ctd = 0;
+    const double fair = future.fairPrice(clean, repo, &ctd);
+
+    BasisAnalytics out;
+    future.analyze(fair, clean, repo, out);
+    REQUIRE(out.cheapest == ctd);
+    // At the option-free fair price the CTD earns exactly the repo rate
+    // and has zero net basis; every other bond earns less
+    REQUIRE(out.impliedRepo[ctd] == Approx(repo).epsilon(1e-12));
+    REQUIRE(out.netBasis[ctd] == Approx(0.0).margin(1e-10));
+    for (std::size_t i = 0; i < future.size(); ++i) {
+      REQUIRE(out.grossBasis[i] ==
+              Approx(clean[i] - fair * future.conversionFactors()[i]));
+      if (i != ctd) {
+        REQUIRE(out.impliedRepo[i] < repo);
+        REQUIRE(out.netBasis[i] > 0.0);
+      }
+    }
+
+    // Clean prices from the curve agree with Bond on a coupon date
+    BondFuture onGrid(0.25, {{0.05, 2, 10.0}});
+    std::vector<double> onGridClean(1);
+    onGrid.cleanPrices(curve, onGridClean);
+    REQUIRE(onGridClean[0] ==
+            Approx(Bond(100.0, 0.05, 2, 10.0).price(curve)).epsilon(1e-12));
+  }
+}
+
+TEST_CASE("Mortgage pool cash flows under prepayment", "[mbs]") {
+  SECTION("Prepayment models") {
+    PrepaymentModel standard = PrepaymentModel::psa(100.0);
+    REQUIRE(standard.annualRate(0) == 0.0);
+    REQUIRE(standard.annualRate(15) == Approx(0.03));
+    REQUIRE(standard.annualRate(30) == Approx(0.06));
+    REQUIRE(standard.annualRate(200) == Approx(0.06));
+    REQUIRE(PrepaymentModel::psa(250.0).annualRate(12) == Approx(0.06));
+
+    PrepaymentModel cpr = PrepaymentModel::constantCpr(0.08);
+    REQUIRE(cpr.smm(7) == Approx(1.0 - std::pow(0.92, 1.0 / 12.0)));
+    REQUIRE_THROWS_AS(PrepaymentModel::constantCpr(1.5),
+                      std::invalid_argument);
+  }
+
+  SECTION("Scheduled amortization is a level payment") {
+    MortgagePool pool{1'000'000.0, 0.06, 0.06, 360, 0};
+    std::vector<CashFlow> flows =
+        PoolCashFlowEngine::project(pool, PrepaymentModel::constantCpr(0.0));
+    REQUIRE(flows.size() == 360);
+    const double r = 0.005;
+    const double payment = pool.balance * r / (1.0 - std::pow(1.0 + r, -360));
+    for (const CashFlow &cf : flows) {
+      REQUIRE(cf.amount == Approx(payment).epsilon(1e-10));
+    }
+    REQUIRE(flows.back().time == Approx(30.0));
+  }
+
+  SECTION("Batched projection matches the reference per pool and scenario") {
+    std::vector<PrepaymentModel> scenarios = {
+        PrepaymentModel::psa(50.0), PrepaymentModel::psa(150.0),
+        PrepaymentModel::psa(400.0), PrepaymentModel::constantCpr(0.12),
+        PrepaymentModel::constantCpr(1.0)};
+    PoolCashFlowEngine engine(scenarios);
+    std::vector<MortgagePool> pools = {{5e6, 0.065, 0.06, 357, 3},
+                                       {2e6, 0.045, 0.04, 120, 60},
+                                       {1e6, 0.0, 0.0, 24, 0}};
+    for (const MortgagePool &pool : pools) {
+      engine.addPool(pool, 2.0);
+    }
+    REQUIRE_THROWS_AS(engine.addPool({1e6, 0.04, 0.05, 360, 0}),
+                      std::invalid_argument);
+
+    CashFlowBlock block = engine.project();
+    REQUIRE(block.positions() == pools.size() * scenarios.size());
+    for (std::size_t p = 0; p < pools.size(); ++p) {
+      for (std::size_t s = 0; s < scenarios.size(); ++s) {
+        std::vector<CashFlow> ref =
+            PoolCashFlowEngine::project(pools[p], scenarios[s]);
+        auto times = block.times(engine.position(p, s));
+        auto amounts = block.amounts(engine.position(p, s));
+        REQUIRE(amounts.size() == ref.size());
+        for (std::size_t i = 0; i < ref.size(); ++i) {
+          REQUIRE(times[i] == ref[i].time);
+          REQUIRE(amounts[i] == Approx(2.0 * ref[i].amount)
+                                    .epsilon(1e-12)
+                                    .margin(1e-6));
+        }
+      }
+    }
+
+    // A zero-coupon pool returns exactly its principal in every scenario
+    for (std::size_t s = 0; s < scenarios.size(); ++s) {
+      double principal = 0.0;
+      for (double a : block.amounts(engine.position(2, s))) {
+        principal += a;
+      }
+      REQUIRE(principal == Approx(2e6));
+    }
+  }
+
+  SECTION("Block positions feed pricing and Sensitivity") {
+    PoolCashFlowEngine engine(
+        {PrepaymentModel::psa(100.0), PrepaymentModel::psa(300.0)});
+    engine.addPool({1e6, 0.055, 0.05, 300, 12});
+    CashFlowBlock block = engine.project();
+
+    DiscountCurve curve(0.045, Compounding::Continuous, DayCount::ACT_365F);
+    std::vector<double> pv(block.positions()), scratch;
+    block.price(curve, 0, block.positions(), pv, scratch);
+
+    for (std::size_t s = 0; s < 2; ++s) {
+      auto times = block.times(s);
+      auto amounts = block.amounts(s);
+      std::vector<CashFlow> flows;
+      for (std::size_t i = 0; i < times.size(); ++i) {
+        flows.push_back({times[i], amounts[i]});
+      }
+      Sensitivity::Moments spans = Sensitivity::moments(
+          times, amounts, 0.045, Compounding::Continuous);
+      Sensitivity::Moments vec =
+          Sensitivity::moments(flows, 0.045, Compounding::Continuous);
+      REQUIRE(spans.price == Approx(vec.price).epsilon(1e-14));
+      REQUIRE(spans.delta == Approx(vec.delta).epsilon(1e-14));
+      REQUIRE(spans.gamma == Approx(vec.gamma).epsilon(1e-14));
+      REQUIRE(spans.price == Approx(pv[s]).epsilon(1e-12));
+    }
+
+    // Faster prepayment shortens the pool
+    double slow = -Sensitivity::moments(block.times(0), block.amounts(0), 0.045,
+                                        Compounding::Continuous)
+                       .delta /
+                  pv[0];
+    double fast = -Sensitivity::moments(block.times(1), block.amounts(1), 0.045,
+                                        Compounding::Continuous)
+                       .delta /
+                  pv[1];
+    REQUIRE(fast < slow);
+  }
+}
@@ -0,0 +1,711 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "../core/CurveRegistry.hpp"
+#include "../core/DfTable.hpp"
+#include "../core/DiscountCurve.hpp"
+#include "../core/HazardCurve.hpp"
+#include "../core/QuoteFeed.hpp"
+#include "../core/SpscRing.hpp"
+#include "../core/SpreadCurve.hpp"
+#include "../engines/CurveBootstrapper.hpp"
+#include "../engines/RiskyBondPricer.hpp"
+#include "../engines/SwapBook.hpp"
+#include "../instruments/Bond.hpp"
+#include "../instruments/Swap.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using namespace quant;
+using Catch::Approx;
+
+namespace {
+
+// Multiply base pillar discount factors by exp(-s*t)
+DiscountCurve shiftCurve(const DiscountCurve &base, double spread) {
+  std::vector<ZeroQuote> quotes(base.pillars());
+  for (auto &q : quotes) {
+    q.df *= std::exp(-spread * q.time);
+  }
+  return DiscountCurve(quotes);
+}
+
+std::vector<ZeroQuote> oisQuotes(double level) {
+  return {{0.5, std::exp(-level * 0.5)},
+          {1.0, std::exp(-level * 1.0)},
+          {5.0, std::exp(-level * 5.0)},
+          {10.0, std::exp(-level * 10.0)}};
+}
+
+} // namespace
+
+TEST_CASE("Curve registry dependency graph", "[curves][registry]") {
+  CurveRegistry registry;
+  registry.addCurve("OIS", DiscountCurve(oisQuotes(0.03)));
+
+  int spreadBuilds = 0;
+  int projectionBuilds = 0;
+  registry.addDerived("ISSUER", {"OIS"},
+                      [&](const std::vector<const DiscountCurve *> &deps) {
+                        ++spreadBuilds;
+                        return shiftCurve(*deps[0], 0.01);
+                      });
+  registry.addDerived("SOFR3M", {"OIS"},
+                      [&](const std::vector<const DiscountCurve *> &deps) {
+                        ++projectionBuilds;
+                        return shiftCurve(*deps[0], 0.002);
+                      });
+  registry.addDerived("ISSUER_SUB", {"ISSUER"},
+                      [](const std::vector<const DiscountCurve *> &deps) {
+                        return shiftCurve(*deps[0], 0.005);
+                      });
+
+  SECTION("Derived curves are built lazily") {
+    REQUIRE(registry.isStale("ISSUER"));
+    REQUIRE(spreadBuilds == 0);
+
+    const DiscountCurve &issuer = registry.curve("ISSUER");
+    REQUIRE(spreadBuilds == 1);
+    REQUIRE(projectionBuilds == 0);
+    REQUIRE(issuer.df(5.0) == Approx(std::exp(-0.04 * 5.0)).margin(1e-12));
+
+    // Second access does not rebuild
+    registry.curve("ISSUER");
+    REQUIRE(spreadBuilds == 1);
+  }
+
+  SECTION("Chained dependencies rebuild in topological order") {
+    const DiscountCurve &sub = registry.curve("ISSUER_SUB");
+    REQUIRE(spreadBuilds == 1);
+    REQUIRE(sub.df(10.0) == Approx(std::exp(-0.045 * 10.0)).margin(1e-12));
+  }
+
+  SECTION("Updates only invalidate downstream curves") {
+    registry.rebuild();
+    REQUIRE(spreadBuilds == 1);
+    REQUIRE(projectionBuilds == 1);
+    std::uint64_t issuerVersion = registry.version("ISSUER");
+
+    registry.update("OIS", DiscountCurve(oisQuotes(0.04)));
+    REQUIRE(registry.isStale("ISSUER"));
+    REQUIRE(registry.isStale("SOFR3M"));
+    REQUIRE(registry.isStale("ISSUER_SUB"));
+
+    // Reference obtained before the rebuild sees the new value afterwards
+    const DiscountCurve &issuer = registry.curve("ISSUER");
+    REQUIRE(issuer.df(1.0) == Approx(std::exp(-0.05)).margin(1e-12));
+    REQUIRE(registry.version("ISSUER") == issuerVersion + 1);
+    REQUIRE(spreadBuilds == 2);
+    REQUIRE(projectionBuilds == 1); // Not requested yet
+
+    REQUIRE(registry.downstream("ISSUER") ==
+            std::vector<std::string>{"ISSUER_SUB"});
+  }
+
+  SECTION("Registration errors") {
+    REQUIRE_THROWS_AS(
+        registry.addCurve("OIS", DiscountCurve(oisQuotes(0.01))),
+        std::invalid_argument);
+    REQUIRE_THROWS_AS(registry.addDerived(
+                          "BAD", {"MISSING"},
+                          [](const std::vector<const DiscountCurve *> &deps) {
+                            return *deps[0];
+                          }),
+                      std::invalid_argument);
+    REQUIRE_FALSE(registry.contains("BAD"));
+    REQUIRE_THROWS_AS(registry.update("ISSUER", DiscountCurve(oisQuotes(0.01))),
+                      std::invalid_argument);
+  }
+}
+
+TEST_CASE("Discount curve batch and log evaluation", "[curves]") {
+  DiscountCurve curve(oisQuotes(0.03));
+  std::vector<double> times = {-1.0, 0.0, 0.25, 0.5, 0.75, 3.0, 10.0, 12.0};
+  std::vector<double> dfs(times.size());
+  curve.df(times, dfs);
+
+  for (std::size_t i = 0; i < times.size(); ++i) {
+    INFO("t = " << times[i]);
+    REQUIRE(dfs[i] == Approx(curve.df(times[i])).margin(1e-15));
+    REQUIRE(curve.logDf(times[i]) ==
+            Approx(std::log(curve.df(times[i]))).margin(1e-14));
+  }
+
+  // Unsorted input falls back to a search per point
+  std::vector<double> reversed(times.rbegin(), times.rend());
+  std::vector<double> out(reversed.size());
+  curve.df(reversed, out);
+  REQUIRE(out.front() == Approx(dfs.back()).margin(1e-15));
+  REQUIRE(out[4] == Approx(dfs[3]).margin(1e-15));
+}
+
+TEST_CASE("Spread curve composed over a base", "[curves][spread]") {
+  DiscountCurve base(oisQuotes(0.03));
+
+  // The base is held by pointer: lvalues only
+  static_assert(std::is_constructible_v<SpreadCurve, DiscountCurve &, double>);
+  static_assert(!std::is_constructible_v<SpreadCurve, DiscountCurve, double>);
+  static_assert(!std::is_constructible_v<SpreadCurve, DiscountCurve,
+                                         QUANT_SPAN<const SpreadQuote>>);
+
+  SECTION("Flat spread matches a materialized curve") {
+    SpreadCurve issuer(base, 0.015);
+    DiscountCurve materialized = shiftCurve(base, 0.015);
+
+    for (double t : {0.5, 1.0, 5.0, 10.0}) {
+      REQUIRE(issuer.df(t) == Approx(materialized.df(t)).margin(1e-14));
+    }
+    REQUIRE(issuer.df(0.0) == 1.0);
+  }
+
+  SECTION("Interpolated spread term structure") {
+    std::vector<SpreadQuote> spreads = {{1.0, 0.01}, {5.0, 0.02}};
+    SpreadCurve issuer(base, spreads);
+
+    REQUIRE(issuer.spread(0.5) == Approx(0.01));
+    REQUIRE(issuer.spread(3.0) == Approx(0.015));
+    REQUIRE(issuer.spread(20.0) == Approx(0.02));
+    REQUIRE(issuer.df(3.0) ==
+            Approx(base.df(3.0) * std::exp(-0.015 * 3.0)).margin(1e-14));
+
+    std::vector<double> times = {0.5, 1.0, 2.0, 3.0, 7.0};
+    std::vector<double> dfs(times.size());
+    issuer.df(times, dfs);
+    for (std::size_t i = 0; i < times.size(); ++i) {
+      REQUIRE(dfs[i] == Approx(issuer.df(times[i])).margin(1e-15));
+    }
+  }
+
+  SECTION("Issuer curves share one base evaluation") {
+    std::vector<double> times = {1.0, 2.0, 5.0};
+    std::vector<double> baseLog(times.size());
+    base.logDf(times, baseLog);
+
+    std::vector<double> dfs(times.size());
+    for (double s : {0.005, 0.01, 0.02}) {
+      SpreadCurve issuer(base, s);
+      issuer.dfFromBase(times, baseLog, dfs);
+      REQUIRE(dfs[2] == Approx(issuer.df(5.0)).margin(1e-15));
+    }
+  }
+}
+
+TEST_CASE("Daily discount factor table", "[curves][dftable]") {
+  DiscountCurve curve(oisQuotes(0.03));
+
+  SECTION("Grid covers the curve out to the last pillar") {
+    DfTable table(curve);
+    REQUIRE(table.horizon() == 10.0);
+    REQUIRE(table.size() == 3651);
+
+    for (int day : {1, 30, 182, 183, 365, 1000, 3650}) {
+      double t = day / 365.0;
+      INFO("day " << day);
+      REQUIRE(table.df(t) == Approx(curve.df(t)).epsilon(1e-12));
+    }
+    REQUIRE(table.df(0.0) == 1.0);
+    REQUIRE(table.df(15.0) == curve.df(15.0)); // beyond grid
+  }
+
+  SECTION("Off-grid times use a linear correction") {
+    DfTable table(curve);
+    for (double t : {0.1234, 2.71828, 7.5}) {
+      REQUIRE(table.df(t) == Approx(curve.df(t)).epsilon(1e-8));
+    }
+  }
+
+  SECTION("Rebuild tracks curve updates") {
+    DiscountCurve bumped(oisQuotes(0.05));
+    DfTable table(curve);
+    table.rebuild(bumped);
+    REQUIRE(table.df(5.0) == Approx(bumped.df(5.0)).epsilon(1e-12));
+  }
+
+  SECTION("Flat curve requires a horizon") {
+    DiscountCurve flat(0.04, Compounding::Semi, DayCount::ACT_365F);
+    REQUIRE_THROWS_AS(DfTable(flat), std::invalid_argument);
+
+    DfTable table(flat, DfTable::kDailyStep, 30.0);
+    REQUIRE(table.df(29.0) == Approx(flat.df(29.0)).epsilon(1e-12));
+  }
+}
+
+TEST_CASE("Zero and forward rate queries", "[curves][rates]") {
+  std::vector<ZeroQuote> quotes = {{0.5, std::exp(-0.020 * 0.5)},
+                                   {2.0, std::exp(-0.030 * 2.0)},
+                                   {10.0, std::exp(-0.040 * 10.0)}};
+  DiscountCurve curve(quotes);
+
+  SECTION("Scalar queries agree with discount factors") {
+    for (double t : {0.25, 0.5, 1.3, 2.0, 7.0, 12.0}) {
+      INFO("t = " << t);
+      REQUIRE(curve.zeroRate(t) ==
+              Approx(-std::log(curve.df(t)) / t).epsilon(1e-13));
+    }
+    REQUIRE(curve.zeroRate(2.0) == Approx(0.03).epsilon(1e-13));
+
+    double fwd = curve.forwardRate(1.0, 3.0);
+    REQUIRE(fwd ==
+            Approx((curve.df(1.0) / curve.df(3.0) - 1.0) / 2.0).epsilon(1e-13));
+
+    // Piecewise-constant instantaneous forward between pillars
+    double expected = (0.040 * 10.0 - 0.030 * 2.0) / 8.0;
+    REQUIRE(curve.instForward(5.0) == Approx(expected).epsilon(1e-13));
+    REQUIRE(curve.instForward(0.1) == 0.0);  // flat DF before first pillar
+    REQUIRE(curve.instForward(20.0) == 0.0); // flat DF after last pillar
+
+    REQUIRE_THROWS_AS(curve.zeroRate(0.0), std::invalid_argument);
+    REQUIRE_THROWS_AS(curve.forwardRate(2.0, 1.0), std::invalid_argument);
+  }
+
+  SECTION("Batched queries match scalar ones") {
+    std::vector<double> schedule = {0.0, 0.25, 0.5, 0.75, 1.0, 1.5, 2.0,
+                                     3.0, 5.0, 10.0, 15.0};
+    std::vector<double> fwds(schedule.size() - 1);
+    curve.forwardRates(schedule, fwds);
+
+    std::vector<double> starts(schedule.begin(), schedule.end() - 1);
+    std::vector<double> ends(schedule.begin() + 1, schedule.end());
+    std::vector<double> fwdsPaired(starts.size());
+    curve.forwardRates(starts, ends, fwdsPaired);
+
+    std::vector<double> inst(ends.size());
+    std::vector<double> zeros(ends.size());
+    curve.instForwards(ends, inst);
+    curve.zeroRates(ends, zeros);
+
+    for (std::size_t i = 0; i < fwds.size(); ++i) {
+      REQUIRE(fwds[i] ==
+              Approx(curve.forwardRate(starts[i], ends[i])).epsilon(1e-14));
+      REQUIRE(fwdsPaired[i] == fwds[i]);
+      REQUIRE(inst[i] == curve.instForward(ends[i]));
+      REQUIRE(zeros[i] == Approx(curve.zeroRate(ends[i])).epsilon(1e-14));
+    }
+  }
+
+  SECTION("Flat curves") {
+    DiscountCurve flat(0.05, Compounding::Semi, DayCount::ACT_365F);
+    double cont = 2.0 * std::log1p(0.025);
+    REQUIRE(flat.zeroRate(3.0) == Approx(cont).epsilon(1e-14));
+    REQUIRE(flat.instForward(3.0) == Approx(cont).epsilon(1e-14));
+    REQUIRE(flat.forwardRate(1.0, 1.5) ==
+            Approx((std::exp(0.5 * cont) - 1.0) / 0.5).epsilon(1e-13));
+  }
+}
+
+TEST_CASE("Bootstrapping and the quote Jacobian", "[curves][bootstrap]") {
+  std::vector<MarketQuote> quotes = {
+      {MarketQuote::Type::Deposit, 0.25, 0.030},
+      {MarketQuote::Type::Deposit, 0.5, 0.032},
+      {MarketQuote::Type::Swap, 1.0, 0.034, 2},
+      {MarketQuote::Type::Swap, 2.0, 0.036, 2},
+      {MarketQuote::Type::Swap, 5.0, 0.038, 1},
+      {MarketQuote::Type::Swap, 10.0, 0.041, 1}};
+
+  auto result = CurveBootstrapper::bootstrap(quotes);
+  DiscountCurve curve = result.curve();
+
+  SECTION("Curve reprices every input instrument") {
+    for (const auto &q : quotes) {
+      INFO("maturity " << q.maturity);
+      if (q.type == MarketQuote::Type::Deposit) {
+        REQUIRE(1.0 / curve.df(q.maturity) - 1.0 ==
+                Approx(q.rate * q.maturity).epsilon(1e-12));
+      } else {
+        double tau = 1.0 / q.fixedFrequency;
+        double annuity = 0.0;
+        for (int j = 1; j * tau <= q.maturity + 1e-12; ++j) {
+          annuity += tau * curve.df(j * tau);
+        }
+        REQUIRE(q.rate * annuity + curve.df(q.maturity) ==
+                Approx(1.0).epsilon(1e-12));
+      }
+    }
+  }
+
+  SECTION("Jacobian matches bump-and-rebuild") {
+    const double h = 1e-6;
+    for (std::size_t j = 0; j < quotes.size(); ++j) {
+      auto up = quotes;
+      auto down = quotes;
+      up[j].rate += h;
+      down[j].rate -= h;
+      auto zUp = CurveBootstrapper::bootstrap(up).zeroRates;
+      auto zDown = CurveBootstrapper::bootstrap(down).zeroRates;
+
+      for (std::size_t i = 0; i < quotes.size(); ++i) {
+        double fd = (zUp[i] - zDown[i]) / (2.0 * h);
+        INFO("dz" << i << "/dq" << j);
+        REQUIRE(result.jacobian(i, j) == Approx(fd).margin(1e-7));
+      }
+    }
+    // Later quotes never move earlier pillars
+    REQUIRE(result.jacobian(1, 4) == 0.0);
+  }
+
+  SECTION("Pillar risk maps to quote risk") {
+    Bond bond(100.0, 0.045, 1, 7.0);
+    const double h = 1e-6;
+    const auto n = static_cast<Eigen::Index>(quotes.size());
+
+    // Pillar risk: reprice with each pillar zero rate bumped
+    auto priceWithZeros = [&](const std::vector<double> &zeros) {
+      std::vector<ZeroQuote> pillars;
+      for (std::size_t i = 0; i < zeros.size(); ++i) {
+        double t = result.pillars[i].time;
+        pillars.push_back({t, std::exp(-zeros[i] * t)});
+      }
+      return bond.price(DiscountCurve(pillars));
+    };
+    Eigen::RowVectorXd pillarRisk(n);
+    for (Eigen::Index i = 0; i < n; ++i) {
+      auto up = result.zeroRates;
+      auto down = result.zeroRates;
+      up[i] += h;
+      down[i] -= h;
+      pillarRisk(i) = (priceWithZeros(up) - priceWithZeros(down)) / (2.0 * h);
+    }
+
+    Eigen::RowVectorXd mapped =
+        CurveBootstrapper::quoteRisk(pillarRisk, result.jacobian);
+
+    for (Eigen::Index j = 0; j < n; ++j) {
+      auto up = quotes;
+      auto down = quotes;
+      up[j].rate += h;
+      down[j].rate -= h;
+      double fd = (bond.price(CurveBootstrapper::bootstrap(up).curve()) -
+                   bond.price(CurveBootstrapper::bootstrap(down).curve())) /
+                  (2.0 * h);
+      INFO("quote " << j);
+      REQUIRE(mapped(j) == Approx(fd).margin(1e-4));
+    }
+
+    // Portfolio form: one row per position
+    Eigen::MatrixXd book(2, n);
+    book.row(0) = pillarRisk;
+    book.row(1) = 2.0 * pillarRisk;
+    Eigen::MatrixXd bookRisk =
+        CurveBootstrapper::quoteRisk(book, result.jacobian);
+    REQUIRE(bookRisk(1, 5) == Approx(2.0 * mapped(5)));
+  }
+}
+
+TEST_CASE("SPSC ring and conflating quote feed", "[curves][feed]") {
+  SECTION("Ring preserves order and reports full/empty") {
+    SpscRing<int> ring(3);
+    REQUIRE(ring.capacity() == 4);
+    for (int i = 0; i < 4; ++i) {
+      REQUIRE(ring.tryPush(i));
+    }
+    REQUIRE_FALSE(ring.tryPush(4));
+
+    int value = -1;
+    REQUIRE(ring.tryPop(value));
+    REQUIRE(value == 0);
+    REQUIRE(ring.tryPush(4));
+
+    std::vector<int> drained;
+    REQUIRE(ring.drain([&](int v) { drained.push_back(v); }, 10) == 4);
+    REQUIRE(drained == std::vector<int>{1, 2, 3, 4});
+    REQUIRE_FALSE(ring.tryPop(value));
+  }
+
+  SECTION("Only the latest value per pillar survives") {
+    QuoteConflator conflator(3);
+    conflator.publish(1, 0.01);
+    conflator.publish(1, 0.02);
+    conflator.publish(0, 0.05);
+    conflator.publish(1, 0.03);
+
+    std::vector<QuoteUpdate> batch;
+    REQUIRE(conflator.drain(batch) == 2);
+    REQUIRE(batch[0].pillar == 1);
+    REQUIRE(batch[0].value == 0.03);
+    REQUIRE(batch[1].pillar == 0);
+    REQUIRE(conflator.published() == 4);
+
+    batch.clear();
+    REQUIRE(conflator.drain(batch) == 0);
+    REQUIRE_THROWS_AS(conflator.publish(3, 0.0), std::out_of_range);
+  }
+
+  SECTION("Curve feed applies a burst in one rebuild") {
+    CurveRegistry registry;
+    CurveFeed feed(registry, "OIS", {1.0, 5.0, 10.0}, {0.03, 0.03, 0.03});
+    registry.addDerived("ISSUER", {"OIS"},
+                        [](const std::vector<const DiscountCurve *> &deps) {
+                          return shiftCurve(*deps[0], 0.01);
+                        });
+
+    for (int k = 1; k <= 100; ++k) {
+      feed.quotes().publish(k % 3, 0.03 + 1e-4 * k);
+    }
+    std::uint64_t before = registry.version("OIS");
+    REQUIRE(feed.pump() == 3);
+    REQUIRE(registry.version("OIS") == before + 1);
+    REQUIRE(feed.rebuilds() == 1);
+    REQUIRE(feed.pump() == 0);
+
+    // Last values: k = 99 -> pillar 0, 100 -> 1, 98 -> 2
+    REQUIRE(registry.curve("OIS").zeroRate(1.0) == Approx(0.0399));
+    REQUIRE(registry.curve("OIS").zeroRate(5.0) == Approx(0.04));
+    REQUIRE(registry.curve("ISSUER").zeroRate(10.0) == Approx(0.0498));
+  }
+
+  SECTION("Concurrent producer never loses the final value") {
+    QuoteConflator conflator(8);
+    const int updates = 200000;
+    std::thread producer([&] {
+      for (int k = 0; k < updates; ++k) {
+        conflator.publish(static_cast<std::uint32_t>(k % 8), k);
+      }
+    });
+
+    std::vector<double> latest(8, -1.0);
+    std::vector<QuoteUpdate> batch;
+    auto apply = [&] {
+      batch.clear();
+      conflator.drain(batch);
+      for (const auto &u : batch) {
+        REQUIRE(u.value >= latest[u.pillar]); // never goes backwards
+        latest[u.pillar] = u.value;
+      }
+    };
+    while (conflator.published() < static_cast<std::uint64_t>(updates)) {
+      apply();
+    }
+    producer.join();
+    apply();
+
+    for (int p = 0; p < 8; ++p) {
+      REQUIRE(latest[p] == updates - 8 + p);
+    }
+  }
+}
+
+TEST_CASE("Swaps: fused valuation, batches and annuity cache",
+          "[curves][swap]") {
+  std::vector<MarketQuote> quotes = {
+      {MarketQuote::Type::Deposit, 0.5, 0.032},
+      {MarketQuote::Type::Swap, 1.0, 0.034, 2},
+      {MarketQuote::Type::Swap, 2.0, 0.036, 2},
+      {MarketQuote::Type::Swap, 5.0, 0.038, 1},
+      {MarketQuote::Type::Swap, 10.0, 0.041, 1}};
+  DiscountCurve curve = CurveBootstrapper::bootstrap(quotes).curve();
+
+  SECTION("Bootstrapped curve reprices its par swaps") {
+    for (const MarketQuote &q : quotes) {
+      if (q.type != MarketQuote::Type::Swap)
+        continue;
+      Swap swap(Swap::Type::Payer, 1e6, q.rate, q.maturity, q.fixedFrequency);
+      SwapValuation v = swap.value(curve);
+      REQUIRE(v.parRate == Approx(q.rate).epsilon(1e-12));
+      REQUIRE(std::abs(v.pv) < 1e-6);
+    }
+  }
+
+  SECTION("Legs, direction and projection curve") {
+    Swap payer(Swap::Type::Payer, 100.0, 0.05, 7.0, 2, 4, 1.0);
+    Swap receiver(Swap::Type::Receiver, 100.0, 0.05, 7.0, 2, 4, 1.0);
+    SwapValuation v = payer.value(curve);
+
+    double annuity = 0.0;
+    for (int j = 1; j <= 12; ++j) {
+      annuity += 100.0 * 0.5 * curve.df(1.0 + 0.5 * j);
+    }
+    REQUIRE(v.annuity == Approx(annuity).epsilon(1e-14));
+    REQUIRE(v.floatLeg == Approx(100.0 * (curve.df(1.0) - curve.df(7.0))));
+    REQUIRE(v.pv == Approx(v.floatLeg - 0.05 * annuity));
+    REQUIRE(receiver.price(curve) == Approx(-v.pv));
+
+    // Projecting off the discount curve itself telescopes back
+    SwapValuation dual = payer.value(curve, curve);
+    REQUIRE(dual.floatLeg == Approx(v.floatLeg).epsilon(1e-12));
+
+    // A higher projection curve raises the floating leg
+    SwapValuation up = payer.value(curve, shiftCurve(curve, 0.01));
+    REQUIRE(up.floatLeg > v.floatLeg);
+    REQUIRE(up.annuity == Approx(v.annuity));
+
+    REQUIRE_THROWS_AS(Swap(Swap::Type::Payer, 100.0, 0.05, 2.3),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(Swap(Swap::Type::Payer, 100.0, 0.05, 2.0, 1, 4, 2.0),
+                      std::invalid_argument);
+  }
+
+  SECTION("Batch matches single swaps") {
+    SwapBook book;
+    std::vector<Swap> swaps;
+    for (int i = 0; i < 50; ++i) {
+      double start = 0.5 * (i % 3);
+      swaps.emplace_back(i % 2 ? Swap::Type::Payer : Swap::Type::Receiver,
+                         1e6 * (1 + i % 3), 0.03 + 0.0002 * i,
+                         start + 1.0 + i % 15, 1 + i % 2, 4, start);
+      REQUIRE(book.add(swaps.back()) == static_cast<std::size_t>(i));
+    }
+    std::vector<SwapValuation> out(book.size());
+    book.value(curve, out);
+    for (std::size_t i = 0; i < swaps.size(); ++i) {
+      SwapValuation v = swaps[i].value(curve);
+      REQUIRE(out[i].pv == Approx(v.pv).margin(1e-8));
+      REQUIRE(out[i].annuity == Approx(v.annuity).epsilon(1e-13));
+      REQUIRE(out[i].parRate == Approx(v.parRate).epsilon(1e-13));
+    }
+  }
+
+  SECTION("Annuities cached per curve version") {
+    CurveRegistry registry;
+    registry.addCurve("OIS", curve);
+    registry.addDerived("WIDE", {"OIS"},
+                        [](const std::vector<const DiscountCurve *> &deps) {
+                          return shiftCurve(*deps[0], 0.005);
+                        });
+    SwapBook book;
+    book.add(Swap(Swap::Type::Payer, 1e6, 0.04, 5.0));
+    book.add(Swap(Swap::Type::Receiver, 2e6, 0.04, 10.0, 2));
+
+    std::vector<double> first = book.annuities(registry, "WIDE");
+    book.annuities(registry, "WIDE");
+    REQUIRE(book.annuityComputations() == 1);
+
+    registry.update("OIS", shiftCurve(curve, 0.001));
+    const std::vector<double> &second = book.annuities(registry, "WIDE");
+    REQUIRE(book.annuityComputations() == 2);
+    REQUIRE(second[0] < first[0]);
+    REQUIRE(second[1] ==
+            Approx(Swap(Swap::Type::Receiver, 2e6, 0.04, 10.0, 2)
+                       .value(registry.curve("WIDE"))
+                       .annuity));
+  }
+
+  SECTION("Same-named curves in different registries are cached apart") {
+    CurveRegistry low;
+    CurveRegistry high;
+    low.addCurve("OIS", curve);
+    high.addCurve("OIS", shiftCurve(curve, 0.01));
+    REQUIRE(low.version("OIS") == high.version("OIS"));
+    REQUIRE(low.instance() != high.instance());
+
+    SwapBook book;
+    book.add(Swap(Swap::Type::Payer, 1e6, 0.04, 5.0));
+
+    const double lowAnnuity = book.annuities(low, "OIS")[0];
+    const double highAnnuity = book.annuities(high, "OIS")[0];
+    REQUIRE(book.annuityComputations() == 2);
+    REQUIRE(highAnnuity < lowAnnuity);
+    REQUIRE(highAnnuity ==
+            Approx(Swap(Swap::Type::Payer, 1e6, 0.04, 5.0)
+                       .value(high.curve("OIS"))
+                       .annuity));
+
+    // Both entries stay warm
+    REQUIRE(book.annuities(low, "OIS")[0] == lowAnnuity);
+    REQUIRE(book.annuities(high, "OIS")[0] == highAnnuity);
+    REQUIRE(book.annuityComputations() == 2);
+
+    // A copy may diverge from its source at the same version
+    CurveRegistry copy = low;
+    REQUIRE(copy.instance() != low.instance());
+    copy.update("OIS", shiftCurve(curve, 0.02));
+    low.update("OIS", curve);
+    REQUIRE(copy.version("OIS") == low.version("OIS"));
+    REQUIRE(book.annuities(copy, "OIS")[0] < highAnnuity);
+    REQUIRE(book.annuities(low, "OIS")[0] == Approx(lowAnnuity));
+    REQUIRE(book.annuityComputations() == 4);
+  }
+}
+
+TEST_CASE("Hazard curves and risky bonds", "[curves][credit]") {
+  DiscountCurve base(0.03, Compounding::Annual, DayCount::ACT_365F);
+
+  SECTION("Survival probabilities") {
+    HazardCurve curve({1.0, 3.0, 5.0}, {0.01, 0.02, 0.03});
+    REQUIRE(curve.survival(0.5) == Approx(std::exp(-0.005)));
+    REQUIRE(curve.survival(2.0) == Approx(std::exp(-0.01 - 0.02)));
+    REQUIRE(curve.survival(7.0) == Approx(std::exp(-0.05 - 0.06 - 0.06)));
+    REQUIRE(curve.hazard(4.0) == 0.03);
+
+    std::vector<double> times = {0.0, 0.3, 1.0, 2.5, 4.0, 9.0};
+    std::vector<double> sorted(times.size()), shuffled(times.size());
+    curve.survival(times, sorted);
+    std::vector<double> reversed(times.rbegin(), times.rend());
+    curve.survival(reversed, shuffled);
+    for (std::size_t i = 0; i < times.size(); ++i) {
+      REQUIRE(sorted[i] == Approx(curve.survival(times[i])).epsilon(1e-15));
+      REQUIRE(shuffled[times.size() - 1 - i] == Approx(sorted[i]));
+    }
+
+    std::vector<double> pillars = {2.0, 5.0};
+    std::vector<double> spreads = {0.012, 0.012};
+    HazardCurve triangle = HazardCurve::fromSpreads(pillars, spreads, 0.4);
+    REQUIRE(triangle.hazards()[0] == Approx(0.02));
+    REQUIRE(triangle.hazards()[1] == Approx(0.02));
+
+    REQUIRE_THROWS_AS(HazardCurve({1.0, 1.0}, {0.01, 0.01}),
+                      std::invalid_argument);
+  }
+
+  SECTION("CDS bootstrap reprices its quotes") {
+    std::vector<CdsQuote> quotes = {
+        {1.0, 0.006}, {3.0, 0.009}, {5.0, 0.012}, {10.0, 0.015}};
+    HazardCurve curve = HazardCurve::bootstrap(base, quotes, 0.4);
+    for (const CdsQuote &q : quotes) {
+      REQUIRE(curve.cdsParSpread(base, q.maturity, q.frequency, 0.4) ==
+              Approx(q.spread).epsilon(1e-10));
+    }
+    // Upward-sloping spreads imply increasing forward hazards
+    for (std::size_t i = 1; i < curve.hazards().size(); ++i) {
+      REQUIRE(curve.hazards()[i] > curve.hazards()[i - 1]);
+    }
+
+    // A spread no hazard up to the cap can reach is not bracketed
+    std::vector<CdsQuote> distressed = {{1.0, 0.01}, {2.0, 10.0}};
+    REQUIRE_THROWS_AS(HazardCurve::bootstrap(base, distressed, 0.4),
+                      std::runtime_error);
+  }
+
+  SECTION("Risky bond pricing and issuer book") {
+    Bond bond(100.0, 0.05, 2, 7.0);
+    REQUIRE(RiskyBondPricer::price(bond, base, HazardCurve::flat(0.0), 0.4) ==
+            Approx(bond.price(base)).epsilon(1e-13));
+    // Full recovery on default at the next coupon date loses little
+    double risky =
+        RiskyBondPricer::price(bond, base, HazardCurve::flat(0.02), 0.4);
+    REQUIRE(risky < bond.price(base));
+    REQUIRE(RiskyBondPricer::price(bond, base, HazardCurve::flat(0.02), 0.0) <
+            risky);
+
+    RiskyBondBook book(2);
+    std::size_t a = book.addIssuer(HazardCurve::flat(0.01), 0.4);
+    std::size_t b =
+        book.addIssuer(HazardCurve({2.0, 10.0}, {0.005, 0.03}), 0.25);
+    std::vector<Bond> bonds;
+    for (int i = 0; i < 20; ++i) {
+      bonds.emplace_back(100.0, 0.03 + 0.001 * i, 1 + i % 2, 1.0 + i % 9);
+      book.add(bonds.back(), 2.0, i % 2 ? a : b);
+    }
+    std::vector<double> out(book.size());
+    REQUIRE_THROWS_AS(book.price(out), std::runtime_error);
+    book.setBaseCurve(base);
+    book.price(out);
+    for (std::size_t i = 0; i < bonds.size(); ++i) {
+      const HazardCurve h = i % 2 ? HazardCurve::flat(0.01)
+                                  : HazardCurve({2.0, 10.0}, {0.005, 0.03});
+      REQUIRE(out[i] == Approx(2.0 * RiskyBondPricer::price(
+                                         bonds[i], base, h,
+                                         i % 2 ? 0.4 : 0.25))
+                            .epsilon(1e-13));
+    }
+
+    // A credit update reprices against the cached discount factors
+    book.setIssuer(a, HazardCurve::flat(0.05), 0.4);
+    std::vector<double> widened(book.size());
+    book.price(widened);
+    REQUIRE(widened[1] < out[1]);
+    REQUIRE(widened[0] == out[0]);
+  }
+}
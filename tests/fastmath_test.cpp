@@ -0,0 +1,171 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "../core/DiscountCurve.hpp"
+#include "../core/FastMath.hpp"
+#include "../engines/Black76.hpp"
+#include "../engines/Sensitivity.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using namespace quant;
+using Catch::Approx;
+
+namespace {
+
+// Maximum error of approx against exact over n evenly spaced points of
+// [lo, hi] (mapped through `point` to the kernel's argument)
+template <typename Approx, typename Exact, typename Point, typename Error>
+double maxError(Approx approx, Exact exact, Point point, Error error,
+                double lo, double hi, int n = 2'000'000) {
+  double worst = 0.0;
+  for (int i = 0; i <= n; ++i) {
+    double x = point(lo + (hi - lo) * i / n);
+    worst = std::max(worst, error(approx(x), exact(x)));
+  }
+  return worst;
+}
+
+double relError(double a, double e) { return std::abs(a / e - 1.0); }
+double absError(double a, double e) { return std::abs(a - e); }
+double identity(double x) { return x; }
+
+} // namespace
+
+TEST_CASE("Fast exp error bound over its domain", "[fastmath]") {
+  auto fast = [](double x) { return fastmath::exp(x); };
+  auto exact = [](double x) { return std::exp(x); };
+
+  double err = maxError(fast, exact, identity, relError, -708.0, 709.78);
+  INFO("max relative error " << err);
+  REQUIRE(err < 2e-11);
+
+  // Typical discounting range, denser grid
+  REQUIRE(maxError(fast, exact, identity, relError, -5.0, 0.0) < 2e-11);
+
+  REQUIRE(fastmath::exp(0.0) == 1.0);
+  REQUIRE(fastmath::exp(-800.0) == 0.0);
+  REQUIRE(std::isinf(fastmath::exp(710.0)));
+  REQUIRE(fastmath::exp(-HUGE_VAL) == 0.0);
+  REQUIRE(fastmath::exp(HUGE_VAL) == HUGE_VAL);
+  REQUIRE(std::isnan(fastmath::exp(std::nan(""))));
+}
+
+TEST_CASE("Fast log error bound over its domain", "[fastmath]") {
+  auto fast = [](double x) { return fastmath::log(x); };
+  auto exact = [](double x) { return std::log(x); };
+  auto logSpaced = [](double u) { return std::exp(u); };
+
+  double abs = maxError(fast, exact, logSpaced, absError, -708.0, 709.0);
+  INFO("max absolute error " << abs);
+  REQUIRE(abs < 1e-12);
+
+  // Relative error near 1, where log itself is small
+  double rel = maxError(fast, exact, identity, relError, 0.5, 0.999999);
+  rel = std::max(rel,
+                 maxError(fast, exact, identity, relError, 1.000001, 2.0));
+  INFO("max relative error near 1 " << rel);
+  REQUIRE(rel < 3e-12);
+
+  REQUIRE(fastmath::log(1.0) == 0.0);
+  REQUIRE(std::isnan(fastmath::log(-1.0)));
+  REQUIRE(std::isinf(fastmath::log(0.0)));
+  REQUIRE(fastmath::log(HUGE_VAL) == HUGE_VAL);
+  REQUIRE(std::isnan(fastmath::log(std::nan(""))));
+  const double tiny = std::numeric_limits<double>::denorm_min();
+  REQUIRE(fastmath::log(tiny) == Approx(std::log(tiny)).epsilon(1e-14));
+}
+
+TEST_CASE("Fast reciprocal square root", "[fastmath]") {
+  auto fast = [](double x) { return fastmath::rsqrt(x); };
+  auto exact = [](double x) { return 1.0 / std::sqrt(x); };
+  auto logSpaced = [](double u) { return std::exp(u); };
+
+  double err = maxError(fast, exact, logSpaced, relError, -700.0, 700.0);
+  INFO("max relative error " << err);
+  REQUIRE(err < 1e-15);
+}
+
+TEST_CASE("Fast normal CDF error bound over its domain", "[fastmath]") {
+  auto fast = [](double x) { return fastmath::normCDF(x); };
+  auto exact = [](double x) { return 0.5 * std::erfc(-x / std::sqrt(2.0)); };
+
+  // Relative error in both tails, down to N(-37) ~ 6e-300
+  double err = maxError(fast, exact, identity, relError, -37.0, 37.0);
+  INFO("max relative error " << err);
+  REQUIRE(err < 1e-7);
+
+  REQUIRE(fastmath::normCDF(0.0) == Approx(0.5).epsilon(1e-11));
+  REQUIRE(fastmath::normCDF(-HUGE_VAL) == 0.0);
+  REQUIRE(fastmath::normCDF(HUGE_VAL) == 1.0);
+  REQUIRE(std::isnan(fastmath::normCDF(std::nan(""))));
+}
+
+TEST_CASE("Precision tier in batched kernels", "[fastmath]") {
+  std::vector<ZeroQuote> quotes = {{0.5, std::exp(-0.02 * 0.5)},
+                                   {5.0, std::exp(-0.03 * 5.0)},
+                                   {30.0, std::exp(-0.04 * 30.0)}};
+  DiscountCurve curve(quotes);
+
+  std::vector<double> times;
+  for (int i = 1; i <= 400; ++i) {
+    times.push_back(0.1 * i);
+  }
+  std::vector<double> exact(times.size()), fast(times.size());
+
+  SECTION("Discount factors") {
+    curve.df(times, exact, Precision::Exact);
+    curve.df(times, fast, Precision::Fast);
+    for (std::size_t i = 0; i < times.size(); ++i) {
+      REQUIRE(fast[i] == Approx(exact[i]).epsilon(1e-8));
+    }
+
+    // Irregular times take the per-time exp path
+    times[1] += 0.013;
+    Sensitivity::discountFactors(times, 0.05, Compounding::Semi, exact,
+                                 Precision::Exact);
+    Sensitivity::discountFactors(times, 0.05, Compounding::Semi, fast,
+                                 Precision::Fast);
+    for (std::size_t i = 0; i < times.size(); ++i) {
+      REQUIRE(fast[i] == Approx(exact[i]).epsilon(1e-8));
+    }
+  }
+
+  SECTION("Black-76 batch") {
+    Black76Batch batch;
+    for (int i = 0; i < 200; ++i) {
+      batch.push_back(1.2, 0.9 + 0.003 * i, 0.25 + 0.05 * i, 0.15, 0.97,
+                      i % 2 == 0);
+    }
+    // Expired and zero-vol lanes take the intrinsic value
+    batch.push_back(1.2, 1.0, 0.0, 0.15, 0.97, true);
+    batch.push_back(1.2, 1.3, 1.0, 0.0, 0.97, false);
+    batch.push_back(1.2, 1.4, -0.5, 0.15, 0.97, false);
+    std::vector<double> px(batch.size()), pxFast(batch.size());
+    Black76::priceBatch(batch, px, Precision::Exact);
+    Black76::priceBatch(batch, pxFast, Precision::Fast);
+
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+      double scalar =
+          Black76::price(batch.forward[i], batch.strike[i], batch.expiry[i],
+                         batch.vol[i], batch.df[i], batch.isCall[i] != 0);
+      REQUIRE(px[i] == Approx(scalar).epsilon(1e-12).margin(1e-15));
+      REQUIRE(std::abs(pxFast[i] - px[i]) < 1e-7 * px[i]);
+    }
+
+    // Out-of-the-money puts priced at a few 1e-4
+    Black76Batch otm;
+    for (int i = 0; i < 50; ++i) {
+      otm.push_back(1.2, 0.9 + 0.001 * i, 0.25, 0.15, 0.97, false);
+    }
+    std::vector<double> otmExact(otm.size()), otmFast(otm.size());
+    Black76::priceBatch(otm, otmExact, Precision::Exact);
+    Black76::priceBatch(otm, otmFast, Precision::Fast);
+    for (std::size_t i = 0; i < otm.size(); ++i) {
+      INFO("strike " << otm.strike[i] << " price " << otmExact[i]);
+      REQUIRE(std::abs(otmFast[i] - otmExact[i]) < 1e-7 * otmExact[i]);
+    }
+  }
+}
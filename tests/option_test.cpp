@@ -1,10 +1,19 @@
+#include "../core/CurveRegistry.hpp"
 #include "../core/DiscountCurve.hpp"
+#include "../engines/Bachelier.hpp"
 #include "../engines/Black76.hpp"
+#include "../engines/ChebyshevProxy.hpp"
 #include "../engines/MonteCarlo.hpp"
+#include "../engines/PreparedOption.hpp"
+#include "../engines/RateOptionBook.hpp"
+#include "../instruments/CapFloor.hpp"
 #include "../instruments/EuropeanBondOption.hpp"
+#include "../instruments/Swaption.hpp"
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <cmath>
+#include <random>
+#include <sstream>
 
 using namespace quant;
 using Catch::Approx;
@@ -193,6 +202,244 @@ TEST_CASE("EuropeanBondOption Interface", "[bond_option]") {
   }
 }
 
+TEST_CASE("Prepared option requote", "[prepared_option]") {
+
+  DiscountCurve curve(0.05, Compounding::Annual, DayCount::ACT_365F);
+
+  SECTION("Single requote matches Black-76") {
+    for (bool isCall : {true, false}) {
+      for (double K : {0.9, 1.25, 1.6}) {
+        PreparedOption prepared(K, 0.75, 0.22, isCall, 5.75);
+        for (double F : {1.0, 1.28, 1.5}) {
+          double expected = Black76::price(F, K, 0.75, 0.22, 0.96, isCall);
+          REQUIRE(prepared.requote(F, 0.96) ==
+                  Approx(expected).epsilon(1e-13).margin(1e-15));
+        }
+      }
+    }
+
+    // Expired and zero-vol options fall back to discounted intrinsic
+    PreparedOption expired(1.2, 0.0, 0.2, true, 5.0);
+    PreparedOption flat(1.2, 1.0, 0.0, false, 6.0);
+    REQUIRE(expired.requote(1.3, 0.9) == Approx(0.9 * 0.1));
+    REQUIRE(flat.requote(1.1, 0.9) == Approx(0.9 * 0.1));
+  }
+
+  SECTION("Curve price matches EuropeanBondOption") {
+    EuropeanBondOption put(EuropeanBondOption::Type::Put, 1.3, 1.5);
+    PreparedOption prepared(put, 0.18);
+    REQUIRE(prepared.underlyingMaturity() == Approx(6.5));
+    REQUIRE(prepared.price(curve) ==
+            Approx(put.priceBlack(curve, 0.18)).epsilon(1e-13));
+  }
+
+  SECTION("Book requote matches single options") {
+    PreparedOptionBook book;
+    std::vector<PreparedOption> options;
+    std::vector<double> forwards, dfs;
+    for (int i = 0; i < 40; ++i) {
+      options.emplace_back(1.0 + 0.02 * i, 0.25 * (i % 8), 0.05 * (i % 5),
+                           i % 2 == 0, 10.0);
+      book.add(options.back());
+      forwards.push_back(1.1 + 0.01 * i);
+      dfs.push_back(0.99 - 0.002 * i);
+    }
+
+    std::vector<double> exact(book.size()), fast(book.size());
+    book.requote(forwards, dfs, exact, Precision::Exact);
+    book.requote(forwards, dfs, fast, Precision::Fast);
+    for (std::size_t i = 0; i < options.size(); ++i) {
+      double expected = options[i].requote(forwards[i], dfs[i]);
+      REQUIRE(exact[i] == Approx(expected).margin(1e-14));
+      REQUIRE(fast[i] == Approx(expected).margin(1e-7));
+    }
+
+    std::vector<double> wrongSize(3);
+    REQUIRE_THROWS_AS(book.requote(forwards, dfs, wrongSize),
+                      std::invalid_argument);
+  }
+
+  SECTION("Invalid inputs") {
+    REQUIRE_THROWS_AS(PreparedOption(0.0, 1.0, 0.2, true, 6.0),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(PreparedOption(1.2, 1.0, 0.2, true, 0.5),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(PreparedOption(1.2, 1.0, 0.2, true, std::nan("")),
+                      std::invalid_argument);
+  }
+}
+
+TEST_CASE("Chebyshev pricing proxy", "[chebyshev_proxy]") {
+
+  const ChebyshevProxy::Axes box = {ChebyshevAxis{1.0, 1.5, 12},
+                                    ChebyshevAxis{0.1, 0.4, 10},
+                                    ChebyshevAxis{0.25, 2.0, 10}};
+  auto black = [](double F, double sigma, double T) {
+    return Black76::price(F, 1.25, T, sigma, 0.95, true);
+  };
+  ChebyshevProxy proxy = ChebyshevProxy::build(black, box, 2);
+
+  SECTION("Accuracy inside the box and tail estimate") {
+    REQUIRE(proxy.sampleCount() == 13 * 11 * 11);
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    double maxError = 0.0;
+    for (int n = 0; n < 500; ++n) {
+      double F = 1.0 + 0.5 * u(rng);
+      double sigma = 0.1 + 0.3 * u(rng);
+      double T = 0.25 + 1.75 * u(rng);
+      maxError = std::max(maxError,
+                          std::abs(proxy(F, sigma, T) - black(F, sigma, T)));
+    }
+    REQUIRE(maxError < 1e-5);
+    // The tail is an order-of-magnitude estimate of the actual error
+    REQUIRE(proxy.errorEstimate() < 1e-4);
+    REQUIRE(maxError < 10.0 * proxy.errorEstimate());
+  }
+
+  SECTION("Box edges and outside points") {
+    REQUIRE(proxy(1.5, 0.4, 2.0) == Approx(black(1.5, 0.4, 2.0)).margin(1e-5));
+    REQUIRE_FALSE(proxy.contains(1.6, 0.2, 1.0));
+    REQUIRE_THROWS_AS(proxy(1.2, 0.2, 2.5), std::out_of_range);
+  }
+
+  SECTION("Serialization round trip is exact") {
+    std::stringstream buffer;
+    proxy.save(buffer);
+    ChebyshevProxy loaded = ChebyshevProxy::load(buffer);
+    REQUIRE(loaded.sampleCount() == proxy.sampleCount());
+    REQUIRE(loaded(1.17, 0.23, 0.8) == proxy(1.17, 0.23, 0.8));
+    REQUIRE(loaded.errorEstimate() == proxy.errorEstimate());
+
+    std::stringstream bad("quant::ChebyshevProxy 1\n0x1p+0 0x1p-1 4\n");
+    REQUIRE_THROWS_AS(ChebyshevProxy::load(bad), std::runtime_error);
+  }
+
+  SECTION("Monte Carlo pricer is interpolated at the nodes") {
+    MonteCarlo::Config config;
+    config.batchSize = 5000;
+    auto mc = [&config](double F, double sigma, double T) {
+      return MonteCarlo::mcPriceAdvanced(F, 1.25, sigma, T, 0.95,
+                                         OptionType::Call, 10000, config);
+    };
+    const ChebyshevProxy::Axes small = {ChebyshevAxis{1.1, 1.4, 3},
+                                        ChebyshevAxis{0.15, 0.3, 2},
+                                        ChebyshevAxis{0.5, 1.5, 2}};
+    ChebyshevProxy mcProxy = ChebyshevProxy::build(mc, small);
+    std::vector<double> F = ChebyshevProxy::nodes(small[0]);
+    std::vector<double> sigma = ChebyshevProxy::nodes(small[1]);
+    std::vector<double> T = ChebyshevProxy::nodes(small[2]);
+    REQUIRE(mcProxy(F[1], sigma[2], T[0]) ==
+            Approx(mc(F[1], sigma[2], T[0])).margin(1e-12));
+  }
+
+  SECTION("Invalid boxes") {
+    ChebyshevProxy::Axes flat = box;
+    flat[1].hi = flat[1].lo;
+    REQUIRE_THROWS_AS(ChebyshevProxy::build(black, flat),
+                      std::invalid_argument);
+    flat = box;
+    flat[2].degree = 0;
+    REQUIRE_THROWS_AS(ChebyshevProxy::build(black, flat),
+                      std::invalid_argument);
+  }
+}
+
+TEST_CASE("Caps, floors and swaptions", "[rate_options]") {
+
+  DiscountCurve curve(0.04, Compounding::Annual, DayCount::ACT_365F);
+
+  SECTION("Bachelier kernel") {
+    // ATM: V = D σ √T / √(2π)
+    double atm = Bachelier::price(0.03, 0.03, 2.0, 0.01, 0.9);
+    REQUIRE(atm == Approx(0.9 * 0.01 * std::sqrt(2.0) / std::sqrt(2 * M_PI)));
+
+    // Put-call parity, including negative rates
+    double call = Bachelier::price(-0.002, 0.001, 1.5, 0.008, 0.97, true);
+    double put = Bachelier::price(-0.002, 0.001, 1.5, 0.008, 0.97, false);
+    REQUIRE(call - put == Approx(0.97 * (-0.003)));
+
+    Black76Batch batch;
+    for (int i = 0; i < 20; ++i) {
+      batch.push_back(0.01 + 0.002 * i, 0.03, 0.5 * (i % 5), 0.007, 0.95,
+                      i % 2 == 0);
+    }
+    std::vector<double> out(batch.size()), fast(batch.size());
+    Bachelier::priceBatch(batch, out, Precision::Exact);
+    Bachelier::priceBatch(batch, fast, Precision::Fast);
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+      REQUIRE(out[i] == Approx(Bachelier::price(batch.forward[i], 0.03,
+                                                batch.expiry[i], 0.007, 0.95,
+                                                batch.isCall[i] != 0))
+                            .margin(1e-15));
+      REQUIRE(fast[i] == Approx(out[i]).margin(1e-12));
+    }
+  }
+
+  SECTION("Cap minus floor is a payer swap") {
+    for (VolatilityType type :
+         {VolatilityType::Lognormal, VolatilityType::Normal}) {
+      double vol = type == VolatilityType::Normal ? 0.008 : 0.2;
+      CapFloor cap(CapFloor::Type::Cap, 1e6, 0.045, 6.0, 4, 1.0);
+      CapFloor floor(CapFloor::Type::Floor, 1e6, 0.045, 6.0, 4, 1.0);
+      Swap swap(Swap::Type::Payer, 1e6, 0.045, 6.0, 4, 4, 1.0);
+      REQUIRE(cap.caplets() == 20);
+      REQUIRE(cap.price(curve, vol, type, Precision::Exact) -
+                  floor.price(curve, vol, type, Precision::Exact) ==
+              Approx(swap.price(curve)).margin(1e-6));
+    }
+  }
+
+  SECTION("Cap book matches single instruments") {
+    CapFloorBook book;
+    std::vector<CapFloor> caps;
+    std::vector<double> vols;
+    for (int i = 0; i < 30; ++i) {
+      caps.emplace_back(i % 3 ? CapFloor::Type::Cap : CapFloor::Type::Floor,
+                        1e6, 0.03 + 0.001 * i, 1.0 + i % 7, i % 2 ? 4 : 2);
+      vols.push_back(i % 2 ? 0.25 : 0.009);
+      book.add(caps.back(), vols.back(),
+               i % 2 ? VolatilityType::Lognormal : VolatilityType::Normal);
+    }
+    REQUIRE(book.size() == 30);
+    std::vector<double> out(book.size());
+    book.price(curve, out, Precision::Exact);
+    for (std::size_t i = 0; i < caps.size(); ++i) {
+      VolatilityType type =
+          i % 2 ? VolatilityType::Lognormal : VolatilityType::Normal;
+      REQUIRE(out[i] == Approx(caps[i].price(curve, vols[i], type,
+                                             Precision::Exact))
+                            .margin(1e-8));
+    }
+  }
+
+  SECTION("Swaptions off cached annuities") {
+    Swap payerSwap(Swap::Type::Payer, 1e6, 0.042, 7.0, 1, 4, 2.0);
+    Swap receiverSwap(Swap::Type::Receiver, 1e6, 0.042, 7.0, 1, 4, 2.0);
+    Swaption payer(payerSwap, 2.0);
+    Swaption receiver(receiverSwap, 2.0);
+
+    // Payer - receiver = forward-starting payer swap
+    REQUIRE(payer.price(curve, 0.2) - receiver.price(curve, 0.2) ==
+            Approx(payerSwap.price(curve)).margin(1e-6));
+    REQUIRE_THROWS_AS(Swaption(payerSwap, 2.5), std::invalid_argument);
+
+    CurveRegistry registry;
+    registry.addCurve("OIS", curve);
+    SwaptionBook book;
+    book.add(payer, 0.2);
+    book.add(receiver, 0.007, VolatilityType::Normal);
+    std::vector<double> out(2);
+    book.price(registry, "OIS", out, Precision::Exact);
+    book.price(registry, "OIS", out, Precision::Exact);
+    REQUIRE(book.swaps().annuityComputations() == 1);
+    REQUIRE(out[0] == Approx(payer.price(curve, 0.2)).epsilon(1e-12));
+    REQUIRE(out[1] ==
+            Approx(receiver.price(curve, 0.007, VolatilityType::Normal))
+                .epsilon(1e-12));
+  }
+}
+
 TEST_CASE("Monte Carlo Engine Validation", "[monte_carlo]") {
 
   SECTION("Antithetic variates effectiveness") {
@@ -0,0 +1,671 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "../core/CurveRegistry.hpp"
+#include "../core/DiscountCurve.hpp"
+#include "../core/HugePages.hpp"
+#include "../core/NumaTopology.hpp"
+#include "../core/Reduction.hpp"
+#include "../engines/PnlAttribution.hpp"
+#include "../engines/Portfolio.hpp"
+#include "../engines/RevaluationEngine.hpp"
+#include "../engines/ShardedPricer.hpp"
+#include "../engines/RiskAggregator.hpp"
+#include "../engines/RiskCache.hpp"
+#include "../engines/TaylorRevaluation.hpp"
+#include "../instruments/Bond.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+using namespace quant;
+using Catch::Approx;
+
+namespace {
+
+DiscountCurve zeroCurve(double level) {
+  std::vector<ZeroQuote> quotes;
+  for (double t : {0.25, 0.5, 1.0, 2.0, 5.0, 10.0, 30.0}) {
+    quotes.push_back({t, std::exp(-level * t)});
+  }
+  return DiscountCurve(quotes);
+}
+
+// Multiply base pillar discount factors by exp(-s*t)
+DiscountCurve shiftCurve(const DiscountCurve &base, double spread) {
+  std::vector<ZeroQuote> quotes(base.pillars());
+  for (auto &q : quotes) {
+    q.df *= std::exp(-spread * q.time);
+  }
+  return DiscountCurve(quotes);
+}
+
+} // namespace
+
+TEST_CASE("Incremental revaluation on curve updates", "[portfolio][reval]") {
+  CurveRegistry registry(2);
+  registry.addCurve("OIS", zeroCurve(0.03));
+  registry.addCurve("EUR", zeroCurve(0.02));
+  registry.addDerived("ISSUER", {"OIS"},
+                      [](const std::vector<const DiscountCurve *> &deps) {
+                        return shiftCurve(*deps[0], 0.01);
+                      });
+
+  RevaluationEngine engine(registry, 2);
+  std::vector<Bond> bonds;
+  std::vector<std::string> curves;
+  std::vector<double> quantities;
+  const char *names[] = {"OIS", "EUR", "ISSUER"};
+  for (int i = 0; i < 30; ++i) {
+    bonds.emplace_back(100.0, 0.02 + 0.001 * i, 2, 1.0 + i % 10);
+    curves.push_back(names[i % 3]);
+    quantities.push_back(1.0 + i);
+    engine.addPosition(bonds.back(), quantities.back(), curves.back());
+  }
+
+  // Reference: reprice the whole book from the registry
+  auto fullTotal = [&]() {
+    double total = 0.0;
+    for (std::size_t i = 0; i < bonds.size(); ++i) {
+      total += quantities[i] * bonds[i].price(registry.curve(curves[i]));
+    }
+    return total;
+  };
+
+  REQUIRE(engine.size() == 30);
+  REQUIRE(engine.total() == Approx(fullTotal()).epsilon(1e-12));
+
+  SECTION("Only dependent positions are repriced") {
+    REQUIRE(engine.updateCurve("EUR", zeroCurve(0.025)) == 10);
+    REQUIRE(engine.total() == Approx(fullTotal()).epsilon(1e-12));
+
+    // OIS feeds the derived issuer curve
+    REQUIRE(engine.updateCurve("OIS", zeroCurve(0.031)) == 20);
+    REQUIRE(engine.total() == Approx(fullTotal()).epsilon(1e-12));
+    REQUIRE(engine.total("ISSUER") ==
+            Approx(engine.value(2) + engine.value(5) + engine.value(8) +
+                   engine.value(11) + engine.value(14) + engine.value(17) +
+                   engine.value(20) + engine.value(23) + engine.value(26) +
+                   engine.value(29)));
+  }
+
+  SECTION("Maturity window skips unaffected positions") {
+    // Move only the 30y pillar: the curve is unchanged up to 10y
+    std::vector<ZeroQuote> quotes(zeroCurve(0.02).pillars());
+    quotes.back().df *= 0.99;
+    REQUIRE(engine.updateCurve("EUR", DiscountCurve(quotes), 10.0) == 0);
+    REQUIRE(engine.total() == Approx(fullTotal()).epsilon(1e-12));
+
+    // Moving the 10y pillar affects everything beyond 5y
+    quotes[5].df *= 0.99;
+    std::size_t beyond5y = 0;
+    for (std::size_t i = 0; i < bonds.size(); ++i) {
+      if (curves[i] == "EUR" && bonds[i].maturity() > 5.0)
+        ++beyond5y;
+    }
+    REQUIRE(engine.updateCurve("EUR", DiscountCurve(quotes), 5.0) == beyond5y);
+    REQUIRE(engine.total() == Approx(fullTotal()).epsilon(1e-12));
+
+    // A cutoff inside the 5y-10y segment still reprices the whole segment
+    quotes[5].df *= 0.99;
+    REQUIRE(engine.updateCurve("EUR", DiscountCurve(quotes), 7.0) == beyond5y);
+    REQUIRE(engine.total() == Approx(fullTotal()).epsilon(1e-12));
+  }
+
+  SECTION("Quantity changes and full revaluation") {
+    engine.setQuantity(4, 0.0);
+    quantities[4] = 0.0;
+    REQUIRE(engine.value(4) == 0.0);
+    REQUIRE(engine.total() == Approx(fullTotal()).epsilon(1e-12));
+
+    for (int k = 0; k < 50; ++k) {
+      engine.updateCurve("OIS", zeroCurve(0.03 + 1e-4 * k));
+    }
+    double incremental = engine.total();
+    engine.revalueAll();
+    REQUIRE(engine.total() == Approx(incremental).epsilon(1e-12));
+    REQUIRE(engine.total() == Approx(fullTotal()).epsilon(1e-12));
+  }
+
+  SECTION("Unknown curves are rejected") {
+    REQUIRE_THROWS_AS(engine.addPosition(bonds[0], 1.0, "GBP"),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(engine.onCurveUpdate("GBP"), std::invalid_argument);
+  }
+}
+
+TEST_CASE("What-if risk against a cached book", "[portfolio][risk]") {
+  DiscountCurve curve(0.04, Compounding::Semi, DayCount::ACT_365F);
+  RiskCache cache(curve, Compounding::Semi, TenorBuckets({2, 5, 10}), 2);
+
+  std::vector<RiskTrade> book;
+  for (int i = 0; i < 20; ++i) {
+    book.push_back({Bond(100.0, 0.03 + 0.002 * i, 2, 1.0 + i), 1.0 + i % 4});
+  }
+  cache.add(book);
+
+  SECTION("Cached totals match Bond analytics") {
+    double dv01 = 0.0;
+    for (const auto &t : book) {
+      dv01 += t.quantity * t.bond.dv01(curve, Compounding::Semi);
+    }
+    REQUIRE(cache.totals().dv01 == Approx(dv01).epsilon(1e-12));
+
+    double bucketSum = 0.0;
+    for (double d : cache.totals().dv01Buckets) {
+      bucketSum += d;
+    }
+    REQUIRE(bucketSum == Approx(dv01).epsilon(1e-12));
+    // 1y and 2y bonds fall in the first bucket
+    auto dv01Of = [&](const RiskTrade &t) {
+      return t.quantity * t.bond.dv01(curve, Compounding::Semi);
+    };
+    REQUIRE(cache.totals().dv01Buckets[0] ==
+            Approx(dv01Of(book[0]) + dv01Of(book[1])));
+    REQUIRE(cache.buckets().label(3) == "10Y+");
+  }
+
+  SECTION("What-if equals booking the trades") {
+    std::vector<RiskTrade> candidates = {{Bond(100.0, 0.05, 2, 7.0), 5.0},
+                                         {Bond(100.0, 0.02, 1, 30.0), -2.0}};
+
+    RiskTotals hypothetical = cache.whatIf(candidates);
+    auto each = cache.whatIfEach(candidates);
+    RiskTotals marginal = cache.marginal(candidates);
+    REQUIRE(cache.size() == 20); // nothing booked
+
+    RiskCache booked(curve, Compounding::Semi, TenorBuckets({2, 5, 10}));
+    booked.add(book);
+    booked.add(candidates);
+
+    REQUIRE(hypothetical.dv01 == Approx(booked.totals().dv01).epsilon(1e-12));
+    REQUIRE(hypothetical.convexity() ==
+            Approx(booked.totals().convexity()).epsilon(1e-12));
+    for (std::size_t b = 0; b < 4; ++b) {
+      REQUIRE(hypothetical.dv01Buckets[b] ==
+              Approx(booked.totals().dv01Buckets[b]).epsilon(1e-12));
+    }
+    REQUIRE(each[0].dv01 + each[1].dv01 - cache.totals().dv01 ==
+            Approx(hypothetical.dv01).epsilon(1e-12));
+    // 7y lands in 5-10Y, 30y in 10Y+
+    REQUIRE(marginal.dv01Buckets[0] == 0.0);
+    REQUIRE(marginal.dv01Buckets[2] + marginal.dv01Buckets[3] ==
+            Approx(marginal.dv01));
+  }
+
+  SECTION("Curve changes refresh the cache") {
+    DiscountCurve shifted(0.05, Compounding::Semi, DayCount::ACT_365F);
+    cache.setCurve(shifted);
+
+    RiskCache fresh(shifted, Compounding::Semi, TenorBuckets({2, 5, 10}));
+    fresh.add(book);
+    REQUIRE(cache.totals().dv01 == fresh.totals().dv01);
+    REQUIRE(cache.totals().marketValue == fresh.totals().marketValue);
+  }
+}
+
+TEST_CASE("Bucketed risk aggregation", "[portfolio][aggregation]") {
+  DiscountCurve curve(0.04, Compounding::Annual, DayCount::ACT_365F);
+  std::vector<RiskRecord> records;
+  for (std::uint32_t i = 0; i < 5000; ++i) {
+    Bond bond(100.0, 0.01 * (1 + i % 7), 1, 1.0 + i % 30);
+    records.push_back(RiskRecord::fromMoments(
+        bond.yieldRisk(curve, Compounding::Annual), 1.0 + i % 3,
+        bond.maturity(), i % 11, i % 3));
+  }
+
+  TenorBuckets tenors({2, 5, 10, 20});
+  RiskCube cube = RiskAggregator(tenors, 11, 3, 4).aggregate(records);
+
+  SECTION("Roll-ups agree with a direct sum") {
+    double mv = 0.0, dv01 = 0.0, durationWeight = 0.0;
+    for (const auto &r : records) {
+      mv += r.marketValue;
+      dv01 += r.dv01;
+      durationWeight += r.marketValue * r.duration;
+    }
+    RiskCell total = cube.total();
+    REQUIRE(total.count == records.size());
+    REQUIRE(total.marketValue == Approx(mv).epsilon(1e-12));
+    REQUIRE(total.dv01 == Approx(dv01).epsilon(1e-12));
+    REQUIRE(total.duration() == Approx(durationWeight / mv).epsilon(1e-12));
+
+    RiskCell tenorSum;
+    for (const auto &cell : cube.byTenor()) {
+      tenorSum += cell;
+    }
+    REQUIRE(tenorSum.dv01 == Approx(dv01).epsilon(1e-12));
+
+    // Issuer 4 in currency 1: records with i % 11 == 4 and i % 3 == 1
+    double issuerDv01 = 0.0;
+    for (std::size_t i = 0; i < records.size(); ++i) {
+      if (i % 11 == 4 && i % 3 == 1)
+        issuerDv01 += records[i].dv01;
+    }
+    REQUIRE(cube.issuer(1, 4).dv01 == Approx(issuerDv01).epsilon(1e-12));
+  }
+
+  SECTION("Results do not depend on the thread count") {
+    // Enough records for several partitions
+    std::vector<RiskRecord> many;
+    for (int copy = 0; copy < 10; ++copy) {
+      many.insert(many.end(), records.begin(), records.end());
+    }
+    RiskCube one = RiskAggregator(tenors, 11, 3, 1).aggregate(many);
+    for (std::size_t threads : {2, 3, 7}) {
+      RiskCube other = RiskAggregator(tenors, 11, 3, threads).aggregate(many);
+      REQUIRE(other.at(2, 7, 3).dv01 == one.at(2, 7, 3).dv01);
+      REQUIRE(other.total().convexityWeight == one.total().convexityWeight);
+      REQUIRE(other.total().count == many.size());
+    }
+  }
+
+  SECTION("Out-of-range keys are rejected") {
+    records.push_back(records.front());
+    records.back().issuer = 11;
+    REQUIRE_THROWS_AS(RiskAggregator(tenors, 11, 3, 2).aggregate(records),
+                      std::invalid_argument);
+  }
+}
+
+TEST_CASE("Reproducible summation", "[portfolio][reduction]") {
+  // Values spanning many magnitudes make naive sums order-sensitive
+  std::vector<double> values;
+  for (int i = 0; i < 100000; ++i) {
+    values.push_back(std::ldexp(1.0 + 1e-3 * (i % 997), (i * 37) % 60 - 30) *
+                     (i % 3 == 0 ? -1.0 : 1.0));
+  }
+
+  double reference = reproducibleSum(values, 1);
+  for (std::size_t threads : {2, 4, 5, 16}) {
+    REQUIRE(reproducibleSum(values, threads) == reference);
+  }
+
+  long double exact = 0.0L;
+  for (double v : values) {
+    exact += v;
+  }
+  REQUIRE(reference == Approx(static_cast<double>(exact)).epsilon(1e-13));
+
+  std::vector<double> odd = {1.0, 2.0, 3.0, 4.0, 5.0};
+  REQUIRE(treeReduce(odd, [](double &a, double b) { a += b; }) == 15.0);
+  REQUIRE(reproducibleSum(std::vector<double>{}) == 0.0);
+}
+
+TEST_CASE("P&L attribution waterfall", "[portfolio][pnl]") {
+  DiscountCurve curve0 = zeroCurve(0.03);
+  std::vector<AttributionPosition> positions;
+  for (int i = 0; i < 12; ++i) {
+    positions.push_back({Bond(100.0, 0.04, 2, 1.0 + 2.0 * i), 1.0 + i % 3,
+                         0.01, 0.01});
+  }
+  PnlAttribution engine({2, 5, 10}, 3);
+  const double dt = 1.0 / 12.0;
+
+  // Reprice outstanding flows at the end date, plus coupons received
+  auto endValue = [&](const AttributionPosition &pos,
+                      const DiscountCurve &curve, double spread) {
+    double v = 0.0;
+    for (const auto &cf : pos.bond.cashFlows()) {
+      v += cf.time <= dt ? cf.amount
+                         : cf.amount * curve.df(cf.time - dt) *
+                               std::exp(-spread * (cf.time - dt));
+    }
+    return v;
+  };
+  auto startValue = [&](const AttributionPosition &pos) {
+    double v = 0.0;
+    for (const auto &cf : pos.bond.cashFlows()) {
+      v += cf.amount * curve0.df(cf.time) * std::exp(-pos.spread0 * cf.time);
+    }
+    return v;
+  };
+
+  SECTION("Components sum to the full revaluation") {
+    std::vector<ZeroQuote> moved(curve0.pillars());
+    for (auto &q : moved) {
+      q.df *= std::exp(-(0.002 + 0.001 * std::sqrt(q.time)) * q.time);
+    }
+    DiscountCurve curve1(moved);
+    positions[3].spread1 = 0.015;
+
+    auto result = engine.attribute(positions, curve0, curve1, dt);
+    for (std::size_t p = 0; p < positions.size(); ++p) {
+      const auto &pos = positions[p];
+      double full = pos.quantity * (endValue(pos, curve1, pos.spread1) -
+                                    startValue(pos));
+      INFO("position " << p);
+      REQUIRE(result[p].total == Approx(full).epsilon(1e-12));
+      REQUIRE(result[p].explained() == Approx(result[p].total).epsilon(1e-12));
+    }
+    REQUIRE(result[3].spread < 0.0);
+    REQUIRE(result[4].spread == Approx(0.0).margin(1e-12));
+
+    Attribution book = engine.sum(result);
+    REQUIRE(book.explained() == Approx(book.total).epsilon(1e-12));
+  }
+
+  SECTION("A parallel move is explained by the parallel step alone") {
+    std::vector<ZeroQuote> shifted(curve0.pillars());
+    for (auto &q : shifted) {
+      q.df *= std::exp(-0.001 * q.time);
+    }
+    auto result =
+        engine.attribute(positions, curve0, DiscountCurve(shifted), dt);
+    for (const auto &a : result) {
+      REQUIRE(a.parallel < 0.0);
+      for (double k : a.keyRates) {
+        REQUIRE(k == Approx(0.0).margin(1e-9));
+      }
+      REQUIRE(a.residual == Approx(0.0).margin(1e-9));
+    }
+  }
+
+  SECTION("Unchanged curve over a period leaves only carry and roll-down") {
+    auto result = engine.attribute(positions, curve0, curve0, dt);
+    for (const auto &a : result) {
+      REQUIRE(a.carry > 0.0);
+      REQUIRE(a.parallel == Approx(0.0).margin(1e-12));
+      REQUIRE(a.residual + a.keyRates[0] + a.keyRates[1] + a.keyRates[2] ==
+              Approx(0.0).margin(1e-9));
+      REQUIRE(a.spread == 0.0);
+    }
+
+    auto still = engine.attribute(positions, curve0, curve0, 0.0);
+    REQUIRE(still[0].total == 0.0);
+    REQUIRE(still[0].carry == 0.0);
+  }
+}
+
+TEST_CASE("NUMA topology and sharded pricing", "[portfolio][numa]") {
+  SECTION("Topology detection and cpulist parsing") {
+    NumaTopology topology = NumaTopology::detect();
+    REQUIRE(topology.nodeCount() >= 1);
+    REQUIRE(topology.cpuCount() >= 1);
+
+    REQUIRE(NumaTopology::parseCpuList("0-3,8,10-11\n") ==
+            std::vector<int>{0, 1, 2, 3, 8, 10, 11});
+    REQUIRE(NumaTopology::parseCpuList("").empty());
+    REQUIRE_THROWS_AS(NumaTopology::parseCpuList("a-b"),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(NumaTopology({}), std::invalid_argument);
+  }
+
+  SECTION("Sharded book matches Bond::price") {
+    std::vector<Bond> bonds;
+    std::vector<double> quantities;
+    for (int i = 0; i < 101; ++i) {
+      bonds.emplace_back(100.0, 0.01 + 0.0005 * i, 1 + i % 4, 1.0 + i % 25);
+      quantities.push_back(i % 5 - 2.0);
+    }
+    DiscountCurve curve = zeroCurve(0.035);
+
+    // Two logical nodes sharing CPU 0 exercise the multi-shard path anywhere
+    NumaTopology twoNodes({{0, {0}}, {1, {0}}});
+    ShardedPricer pricer(bonds, quantities, twoNodes, 2);
+    REQUIRE(pricer.shards() == 2);
+    REQUIRE(pricer.size() == 101);
+
+    double total = pricer.price(curve);
+    double expected = 0.0;
+    for (std::size_t i = 0; i < bonds.size(); ++i) {
+      double v = quantities[i] * bonds[i].price(curve);
+      REQUIRE(pricer.value(i) == Approx(v).margin(1e-10));
+      expected += v;
+    }
+    REQUIRE(total == Approx(expected).epsilon(1e-12));
+    REQUIRE(pricer.values().size() == 101);
+
+    ShardedPricer local(bonds, quantities);
+    REQUIRE(local.price(curve) == Approx(expected).epsilon(1e-12));
+  }
+}
+
+TEST_CASE("Huge-page backed buffers", "[portfolio][hugepages]") {
+  const std::size_t big = std::size_t{4} << 20;
+  auto tracked = [](const char *tag) {
+    for (const auto &r : hugePageReport()) {
+      if (r.tag == tag)
+        return true;
+    }
+    return false;
+  };
+
+  SECTION("Huge pages are opt-in") {
+    REQUIRE(hugePagePolicy() == HugePagePolicy::Off);
+  }
+
+  SECTION("Large buffers are tracked and small ones are not") {
+    {
+      HugePageVector<double> large(big / sizeof(double), 1.0,
+                                   HugePageAllocator<double>("test.large"));
+      HugePageVector<double> small(16, 2.0,
+                                   HugePageAllocator<double>("test.small"));
+      REQUIRE(large[big / sizeof(double) - 1] == 1.0);
+      REQUIRE(tracked("test.large"));
+      REQUIRE_FALSE(tracked("test.small"));
+    }
+    REQUIRE_FALSE(tracked("test.large"));
+  }
+
+  SECTION("Policy off falls back to regular pages") {
+    setHugePagePolicy(HugePagePolicy::Off);
+    void *p = hugePageAllocate(big, "test.off");
+    auto report = hugePageReport();
+    bool regular = false;
+    for (const auto &r : report) {
+      if (r.tag == std::string("test.off"))
+        regular = r.backing == PageBacking::Regular;
+    }
+    REQUIRE(regular);
+    hugePageDeallocate(p, big);
+  }
+
+  SECTION("Transparent backing reflects what the kernel provided") {
+    setHugePagePolicy(HugePagePolicy::Transparent);
+    {
+      HugePageVector<double> v(big / sizeof(double), 1.0,
+                               HugePageAllocator<double>("test.thp"));
+      for (const auto &r : hugePageReport()) {
+        if (r.tag != std::string("test.thp"))
+          continue;
+        REQUIRE(r.hugeBytes <= big);
+        REQUIRE((r.backing == PageBacking::Transparent) ==
+                (r.hugeBytes > 0));
+      }
+    }
+    setHugePagePolicy(HugePagePolicy::Off);
+  }
+
+  SECTION("Explicit policy falls back when no pool is reserved") {
+    setHugePagePolicy(HugePagePolicy::Explicit);
+    HugePageVector<double> v(big / sizeof(double), 3.0,
+                             HugePageAllocator<double>("test.explicit"));
+    REQUIRE(v.front() == 3.0);
+    REQUIRE(tracked("test.explicit"));
+    setHugePagePolicy(HugePagePolicy::Off);
+  }
+}
+
+TEST_CASE("Mixed portfolio priced by type blocks", "[portfolio][variant]") {
+  DiscountCurve curve = zeroCurve(0.04);
+  Portfolio portfolio;
+  std::vector<double> expected;
+
+  for (int i = 0; i < 40; ++i) {
+    if (i % 3 == 0) {
+      auto type = i % 2 ? EuropeanBondOption::Type::Call
+                        : EuropeanBondOption::Type::Put;
+      EuropeanBondOption option(type, 1.1 + 0.01 * i, 0.5 + 0.1 * i);
+      double sigma = 0.1 + 0.005 * i;
+      portfolio.add(BondOptionPosition{option, sigma, 2.0});
+      expected.push_back(2.0 * option.priceBlack(curve, sigma));
+    } else {
+      Bond bond(100.0, 0.03 + 0.001 * i, 2, 1.0 + i % 12);
+      portfolio.add(BondPosition{bond, -1.5});
+      expected.push_back(-1.5 * bond.price(curve));
+    }
+  }
+
+  REQUIRE(portfolio.size() == 40);
+  REQUIRE(portfolio.count<BondOptionPosition>() == 14);
+  REQUIRE(portfolio.count<BondPosition>() == 26);
+
+  // Results come back in insertion order
+  auto values = portfolio.price(curve);
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    INFO("instrument " << i);
+    REQUIRE(values[i] == Approx(expected[i]).epsilon(1e-12));
+  }
+
+  std::vector<double> tooSmall(3);
+  REQUIRE_THROWS_AS(portfolio.price(curve, tooSmall), std::invalid_argument);
+}
+
+TEST_CASE("Taylor revaluation between full refreshes", "[portfolio][taylor]") {
+  DiscountCurve base = zeroCurve(0.03);
+  std::vector<Bond> bonds;
+  std::vector<EuropeanBondOption> options;
+  std::vector<double> vols;
+  for (int i = 0; i < 12; ++i) {
+    bonds.emplace_back(100.0, 0.02 + 0.002 * i, 2, 1.0 + i);
+    options.emplace_back(i % 2 ? EuropeanBondOption::Type::Call
+                               : EuropeanBondOption::Type::Put,
+                         1.1 + 0.02 * i, 0.5 + 0.25 * (i % 4));
+    vols.push_back(0.15 + 0.01 * (i % 3));
+  }
+
+  auto exactValue = [&](const DiscountCurve &curve,
+                        const std::vector<double> &v) {
+    double total = 0.0;
+    for (std::size_t i = 0; i < bonds.size(); ++i) {
+      total += 10.0 * bonds[i].price(curve);
+      total += 1000.0 * options[i].priceBlack(curve, v[i]);
+    }
+    return total;
+  };
+
+  auto makeBook = [&](double positionBudget, double bookBudget) {
+    TaylorRevaluation::Config config;
+    config.positionErrorBudget = positionBudget;
+    config.bookErrorBudget = bookBudget;
+    TaylorRevaluation book(config, 2);
+    for (std::size_t i = 0; i < bonds.size(); ++i) {
+      book.addBond(bonds[i], 10.0);
+      book.addOption(options[i], 1000.0);
+    }
+    book.fullRevalue(base, vols);
+    return book;
+  };
+
+  SECTION("Small moves stay within the estimated error") {
+    TaylorRevaluation book = makeBook(1e6, 1e6);
+    REQUIRE(book.referenceValue() == Approx(exactValue(base, vols)));
+
+    std::vector<double> moved(vols);
+    for (double &v : moved) {
+      v += 0.002;
+    }
+    DiscountCurve shifted = shiftCurve(base, 0.0005);
+    auto tick = book.onTick(shifted, moved);
+    const double exact = exactValue(shifted, moved);
+
+    REQUIRE(tick.repriced == 0);
+    REQUIRE_FALSE(tick.refreshRecommended);
+    REQUIRE(tick.pnl == Approx(exact - book.referenceValue()).epsilon(1e-3));
+    REQUIRE(std::abs(tick.value - exact) < tick.errorEstimate);
+    REQUIRE(book.ticksSinceRefresh() == 1);
+  }
+
+  SECTION("Large moves trigger targeted repricing") {
+    TaylorRevaluation book = makeBook(1e-9, 1e6);
+    DiscountCurve shifted = shiftCurve(base, 0.01);
+    std::vector<double> moved(vols);
+    moved[3] += 0.05;
+    auto tick = book.onTick(shifted, moved);
+
+    // Every position is out of a zero budget, so the result is exact
+    REQUIRE(tick.repriced == bonds.size() + options.size());
+    REQUIRE(tick.value == Approx(exactValue(shifted, moved)).epsilon(1e-12));
+    REQUIRE(tick.errorEstimate == 0.0);
+
+    // Re-anchored positions expand around the new market
+    auto again = book.onTick(shifted, moved);
+    REQUIRE(again.repriced == 0);
+    REQUIRE(again.value == Approx(tick.value).epsilon(1e-12));
+  }
+
+  SECTION("Non-parallel moves feed the error estimate") {
+    // Short end up 100bp with the 10y point fixed: the 10y zero rate, and
+    // so any single maturity factor, does not move
+    TaylorRevaluation::Config config;
+    config.positionErrorBudget = 1e6;
+    config.bookErrorBudget = 1e-6;
+    TaylorRevaluation book(config);
+    Bond tenYear(100.0, 0.05, 2, 10.0);
+    book.addBond(tenYear, 1.0);
+    book.fullRevalue(base, {});
+
+    std::vector<ZeroQuote> quotes(base.pillars());
+    for (auto &q : quotes) {
+      if (q.time < 10.0)
+        q.df *= std::exp(-0.01 * q.time);
+    }
+    DiscountCurve twisted(quotes);
+    const double exact = tenYear.price(twisted);
+    REQUIRE(exact < book.referenceValue() - 0.5);
+
+    auto tick = book.onTick(twisted, {});
+    REQUIRE(std::abs(tick.value - exact) < tick.errorEstimate);
+    REQUIRE(tick.refreshRecommended);
+
+    // With a tight position budget the bond is repriced exactly
+    config.positionErrorBudget = 1e-6;
+    TaylorRevaluation tight(config);
+    tight.addBond(tenYear, 1.0);
+    tight.fullRevalue(base, {});
+    auto repriced = tight.onTick(twisted, {});
+    REQUIRE(repriced.repriced == 1);
+    REQUIRE(repriced.value == Approx(exact).epsilon(1e-12));
+
+    // A hump between two nodes is caught through the maturity residual
+    std::vector<ZeroQuote> humped(base.pillars());
+    humped.push_back({8.0, std::exp(-0.04 * 8.0)});
+    std::sort(humped.begin(), humped.end(),
+              [](const ZeroQuote &a, const ZeroQuote &b) {
+                return a.time < b.time;
+              });
+    TaylorRevaluation::Config coarse;
+    coarse.positionErrorBudget = 1e6;
+    coarse.keyRates = TenorBuckets({1, 5, 10, 30});
+    TaylorRevaluation sparse(coarse);
+    Bond eightYear(100.0, 0.04, 2, 8.0);
+    sparse.addBond(eightYear, 1.0);
+    sparse.fullRevalue(base, {});
+    auto hump = sparse.onTick(DiscountCurve(humped), {});
+    REQUIRE(hump.repriced == 0);
+    REQUIRE(std::abs(hump.value - eightYear.price(DiscountCurve(humped))) <
+            hump.errorEstimate);
+  }
+
+  SECTION("Book budget recommends a full refresh") {
+    TaylorRevaluation book = makeBook(1e6, 1e-6);
+    auto tick = book.onTick(shiftCurve(base, 0.01), vols);
+    REQUIRE(tick.repriced == 0);
+    REQUIRE(tick.refreshRecommended);
+
+    book.fullRevalue(shiftCurve(base, 0.01), vols);
+    REQUIRE(book.ticksSinceRefresh() == 0);
+    REQUIRE_FALSE(book.onTick(shiftCurve(base, 0.01), vols)
+                      .refreshRecommended);
+  }
+
+  SECTION("Misuse") {
+    TaylorRevaluation book;
+    book.addBond(bonds[0], 1.0);
+    REQUIRE_THROWS_AS(book.onTick(base, {}), std::runtime_error);
+    book.fullRevalue(base, {});
+    REQUIRE_THROWS_AS(book.onTick(base, vols), std::invalid_argument);
+  }
+}